@@ -0,0 +1,157 @@
+# Script mode helper of the compile time benchmarks, see CMakeLists.txt
+#
+# MODE=measure: generates the source of KERNEL with SIZE members, compiles it, and writes a single CSV row to OUTPUT
+# MODE=merge: concatenates the rows in INPUTS into OUTPUT, with a header
+#
+# Columns:
+# * wall_ms: wall time of the compiler invocation
+# * peak_rss_kb: peak memory of the compiler, if /usr/bin/time is available
+# * compiler_memory_kb: memory allocated by the compiler itself (GCC -ftime-report)
+# * instantiations: template instantiations (clang -ftime-trace)
+cmake_minimum_required(VERSION 3.23)
+
+set(header "kernel,size,compiler,wall_ms,peak_rss_kb,compiler_memory_kb,instantiations")
+
+if(MODE STREQUAL "merge")
+  set(content "${header}\n")
+  foreach(input ${INPUTS})
+    file(READ ${input} row)
+    string(APPEND content "${row}")
+  endforeach()
+  file(WRITE ${OUTPUT} "${content}")
+  message(STATUS "Compile time benchmark results: ${OUTPUT}")
+  return()
+endif()
+
+# Source generation
+# =================
+
+math(EXPR last "${SIZE} - 1")
+
+if(KERNEL STREQUAL "list_size" OR KERNEL STREQUAL "list_at")
+  set(src "#include \"tsar/list.hpp\"\n#include <type_traits>\n\nstruct bench_list {};\n\n")
+  foreach(i RANGE ${last})
+    string(APPEND src "struct item${i} : tsar::list::link<bench_list, item${i}> {};\n")
+  endforeach()
+  if(KERNEL STREQUAL "list_size")
+    string(APPEND src "\nstatic_assert(tsar::list::size(bench_list{}, []() {}) == ${SIZE});\n")
+  else()
+    math(EXPR middle "${SIZE} / 2")
+    foreach(i 0 ${middle} ${last})
+      string(APPEND src "static_assert(std::is_same_v<decltype(tsar::list::at<bench_list, ${i}>()), item${i}*>);\n")
+    endforeach()
+  endif()
+elseif(KERNEL STREQUAL "log_search")
+  # one independent search for every member, as every item of a list performs one
+  set(src "#include \"tsar/log_search.hpp\"\n\n")
+  foreach(i RANGE ${last})
+    string(APPEND src "static_assert(tsar::log_search([]<std::size_t Idx, typename Id>() consteval { return Idx < ${i}; }) == ${i});\n")
+  endforeach()
+elseif(KERNEL STREQUAL "member_at" OR KERNEL STREQUAL "member_at_all")
+  set(src "#include \"tsar/field.hpp\"\n#include <utility>\n\nTSAR_STRUCT(bench_struct) {\n")
+  foreach(i RANGE ${last})
+    string(APPEND src "  TSAR_FIELD(int, f${i});\n")
+  endforeach()
+  string(APPEND src "};\n\nstatic_assert(bench_struct::meta().size() == ${SIZE});\n")
+  if(KERNEL STREQUAL "member_at")
+    math(EXPR middle "${SIZE} / 2")
+    foreach(i 0 ${middle} ${last})
+      string(APPEND src "static_assert(bench_struct::meta().member_at<${i}>().offset() == ${i} * sizeof(int));\n")
+    endforeach()
+  else()
+    # visits every field, like serializers and other generic code do
+    string(APPEND src "template <std::size_t... Is>\n"
+                      "constexpr std::size_t offset_sum(std::index_sequence<Is...>) {\n"
+                      "  return (0 + ... + bench_struct::meta().member_at<Is>().offset());\n"
+                      "}\n"
+                      "static_assert(offset_sum(std::make_index_sequence<${SIZE}>()) == ${SIZE} * ${last} / 2 * sizeof(int));\n")
+  endif()
+elseif(KERNEL STREQUAL "st_add" OR KERNEL STREQUAL "st_of")
+  set(src "#include \"tsar/st.hpp\"\n\n")
+  foreach(i RANGE ${last})
+    string(APPEND src "struct key${i} {};\n")
+  endforeach()
+  if(KERNEL STREQUAL "st_add")
+    string(APPEND src "\nusing bench_tuple = decltype(tsar::st<tsar::ordering::optimal>{}")
+    foreach(i RANGE ${last})
+      string(APPEND src "\n    .add<int>(key${i}{})")
+    endforeach()
+    string(APPEND src ")::tuple_t;\n")
+  else()
+    string(APPEND src "\nusing bench_tuple = tsar::st<tsar::ordering::optimal>::of<")
+    foreach(i RANGE ${last})
+      if(i GREATER 0)
+        string(APPEND src ",")
+      endif()
+      string(APPEND src "\n    tsar::st_entry<key${i}, int>")
+    endforeach()
+    string(APPEND src ">;\n")
+  endif()
+  string(APPEND src "static_assert(sizeof(bench_tuple) == ${SIZE} * sizeof(int));\n")
+  math(EXPR middle "${SIZE} / 2")
+  foreach(i 0 ${middle} ${last})
+    string(APPEND src "static_assert(bench_tuple::offset(key${i}{}) == ${i} * sizeof(int));\n")
+  endforeach()
+else()
+  message(FATAL_ERROR "Unknown compile time benchmark: ${KERNEL}")
+endif()
+
+string(APPEND src "\nint main() { return 0; }\n")
+
+file(MAKE_DIRECTORY ${WORK_DIR})
+set(source ${WORK_DIR}/${KERNEL}_${SIZE}.cxx)
+set(object ${WORK_DIR}/${KERNEL}_${SIZE}.o)
+file(WRITE ${source} "${src}")
+
+# Measurement
+# ===========
+
+set(command ${COMPILER} -std=c++20 -fsyntax-only -Wno-invalid-offsetof -I${INCLUDE_DIR} ${source})
+if(COMPILER_ID STREQUAL "GNU")
+  list(APPEND command -ftime-report -ftemplate-depth=4096)
+elseif(COMPILER_ID MATCHES "Clang")
+  # -fsyntax-only doesn't write the trace, compile to an object instead
+  list(REMOVE_ITEM command -fsyntax-only)
+  list(APPEND command -c -o ${object} -ftime-trace)
+endif()
+
+set(rss_file ${WORK_DIR}/${KERNEL}_${SIZE}.rss)
+if(TIME_EXECUTABLE)
+  list(PREPEND command ${TIME_EXECUTABLE} -f %M -o ${rss_file})
+endif()
+
+string(TIMESTAMP start "%s%f" UTC)
+execute_process(COMMAND ${command} RESULT_VARIABLE result OUTPUT_VARIABLE out ERROR_VARIABLE err)
+string(TIMESTAMP end "%s%f" UTC)
+
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "Compile time benchmark ${KERNEL}_${SIZE} failed to compile:\n${err}")
+endif()
+
+math(EXPR wall_ms "(${end} - ${start}) / 1000")
+
+set(peak_rss_kb "")
+if(TIME_EXECUTABLE AND EXISTS ${rss_file})
+  file(STRINGS ${rss_file} peak_rss_kb LIMIT_COUNT 1 REGEX "^[0-9]+$")
+endif()
+
+set(compiler_memory_kb "")
+if(err MATCHES "TOTAL[ \t:]+[0-9. \t]+[ \t]([0-9]+)([kMG])")
+  set(compiler_memory_kb ${CMAKE_MATCH_1})
+  if(CMAKE_MATCH_2 STREQUAL "M")
+    math(EXPR compiler_memory_kb "${compiler_memory_kb} * 1024")
+  elseif(CMAKE_MATCH_2 STREQUAL "G")
+    math(EXPR compiler_memory_kb "${compiler_memory_kb} * 1024 * 1024")
+  endif()
+endif()
+
+set(instantiations "")
+set(trace ${WORK_DIR}/${KERNEL}_${SIZE}.json)
+if(EXISTS ${trace})
+  file(READ ${trace} trace_content)
+  string(REGEX MATCHALL "\"name\":\"Instantiate(Class|Function)\"" events "${trace_content}")
+  list(LENGTH events instantiations)
+endif()
+
+file(WRITE ${OUTPUT} "${KERNEL},${SIZE},${COMPILER_ID},${wall_ms},${peak_rss_kb},${compiler_memory_kb},${instantiations}\n")
+message(STATUS "${KERNEL} (${SIZE}): ${wall_ms} ms")
@@ -0,0 +1,165 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <array>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "tsar/cat.hpp"
+#include "tsar/context_aware_tuple.hpp"
+#include "tsar/field.hpp"
+#include "tsar/observable/observable.hpp"
+#include "tsar/standard_tuple.hpp"
+
+// Every tsar access is measured next to the equivalent plain C++ access, the pairs should take the same time
+
+namespace bench {
+
+constexpr std::size_t count = 1024;
+
+TSAR_STRUCT(tsar_point) {
+  TSAR_FIELD(int, x);
+  TSAR_FIELD(int, y);
+  TSAR_FIELD(int, z);
+};
+
+struct plain_point {
+  int x;
+  int y;
+  int z;
+};
+
+template <typename CTX>
+struct context_aware_item {
+  int i = 1;
+
+  int sibling() { return CTX::container(this).template get<0>().i; }
+};
+
+struct plain_pair {
+  struct item {
+    int i = 1;
+  };
+
+  item first;
+  item second;
+};
+
+struct marker_1 {};
+
+template <typename T>
+struct counting_observer : tsar::observable::observer_t<T> {
+  std::size_t events = 0;
+  void on_changed(T const& /* unused */) override { ++events; }
+};
+
+}  // namespace bench
+
+using namespace bench;
+
+TEST_CASE("Field access through enclosing()") {
+  std::vector<tsar_point> tsar_points(count);
+  std::vector<plain_point> plain_points(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    tsar_points[i].x = static_cast<int>(i);
+    plain_points[i].x = static_cast<int>(i);
+  }
+
+  BENCHMARK("tsar enclosing") {
+    int sum = 0;
+    for (auto& p : tsar_points) {
+      sum += p.z.enclosing().x;
+    }
+    return sum;
+  };
+
+  BENCHMARK("plain struct") {
+    int sum = 0;
+    for (auto& p : plain_points) {
+      sum += p.x;
+    }
+    return sum;
+  };
+}
+
+TEST_CASE("standard_tuple get") {
+  std::vector<tsar::standard_tuple<char, double, int>> tsar_tuples(count);
+  std::vector<tsar::sorted_standard_tuple<char, double, int>> sorted_tuples(count);
+  std::vector<std::tuple<char, double, int>> std_tuples(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    tsar_tuples[i].get<2>() = sorted_tuples[i].get<2>() = std::get<2>(std_tuples[i]) = static_cast<int>(i);
+  }
+
+  BENCHMARK("tsar standard_tuple") {
+    int sum = 0;
+    for (auto& t : tsar_tuples) {
+      sum += t.get<2>();
+    }
+    return sum;
+  };
+
+  BENCHMARK("tsar sorted_standard_tuple") {
+    int sum = 0;
+    for (auto& t : sorted_tuples) {
+      sum += t.get<2>();
+    }
+    return sum;
+  };
+
+  BENCHMARK("std::tuple") {
+    int sum = 0;
+    for (auto& t : std_tuples) {
+      sum += std::get<2>(t);
+    }
+    return sum;
+  };
+}
+
+TEST_CASE("context_aware_tuple member access") {
+  std::vector<tsar::context_aware_tuple<context_aware_item, context_aware_item>> tsar_tuples(count);
+  std::vector<plain_pair> plain_pairs(count);
+
+  BENCHMARK("tsar sibling through the container") {
+    int sum = 0;
+    for (auto& t : tsar_tuples) {
+      sum += t.get<1>().sibling();
+    }
+    return sum;
+  };
+
+  BENCHMARK("plain struct") {
+    int sum = 0;
+    for (auto& p : plain_pairs) {
+      sum += p.first.i;
+    }
+    return sum;
+  };
+}
+
+TEST_CASE("observer_registry fire") {
+  using namespace tsar::observable;
+
+  for (std::size_t observers : {0, 1, 8, 64}) {
+    auto o = tsar::cat{}
+                 .add<observer_registry>(observer_registry_marker{})
+                 .add<observable<int>::type>(marker_1{})
+                 .build();
+
+    std::vector<counting_observer<int>> registered(observers);
+    for (auto& observer : registered) {
+      o.get(marker_1{}).observe(observer);
+    }
+
+    int value = 0;
+    BENCHMARK("fire, " + std::to_string(observers) + " observers") {
+      // every assignment changes the value, so every assignment fires
+      o.get(marker_1{}) = ++value;
+    };
+
+    for (auto& observer : registered) {
+      o.get(marker_1{}).unobserve(observer);
+    }
+  }
+}
@@ -46,11 +46,26 @@ struct kittens {
 
 }  // namespace cat_detail
 
+// An item of the context aware type ITEM, accessed with the key KEY, see cat::of
+template <typename KEY, template <typename> typename ITEM>
+using cat_entry = cat_detail::pair<KEY, ITEM>;
+
 struct cat {
   template <template <typename> typename ITEM, typename KEY>
   auto add(KEY k) {
     return cat_detail::kittens<cat_detail::pair<KEY, ITEM>>{};
   }
+
+  // The tuple type with every entry, built in a single step:
+  //   tsar::cat::of<tsar::cat_entry<marker_1, item_a>, tsar::cat_entry<marker_2, item_b>>
+  //
+  // Chained add calls instantiate a longer kittens type for every entry, see st::of.
+  template <typename... ENTRIES>
+  using of = typename cat_detail::kitten_march<ENTRIES...>::tuple_t;
+
+  // The builder with every entry, which can be extended with add, or used as an observable composite
+  template <typename... ENTRIES>
+  using kittens_of = cat_detail::kittens<ENTRIES...>;
 };
 
 }  // namespace tsar
\ No newline at end of file
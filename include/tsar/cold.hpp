@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "tsar/field.hpp"
+
+// Hot / cold splitting of TSAR_STRUCTs
+//
+// TSAR_STRUCT(entity) {
+//   TSAR_FIELD(float, x);
+//   TSAR_FIELD(float, y);
+//   TSAR_COLD_FIELD(std::string, debug_name);
+//   TSAR_COLD_FIELD(std::vector<int>, history);
+//
+//   TSAR_COLD_STORAGE();
+// };
+//
+// Cold fields don't take up space in the struct itself (sizeof(entity) is 2 floats + 1 pointer),
+// so arrays of entities keep the hot fields densely packed in the cache.
+// The values of every cold field are stored together in one separately allocated block,
+// which is allocated on the first non-const access of any cold field.
+// Until then, const accesses return value initialized defaults.
+//
+// Copying the struct copies the cold block, moving it transfers the ownership of the block.
+
+#define TSAR_COLD_STORAGE() tsar::cold_block<struct_t> tsar_cold
+
+namespace tsar {
+
+namespace cold_detail {
+
+template <typename S>
+using meta_t = struct_meta<typename S::tsar_struct_t, cts<S::_name.size()>{S::_name}>;
+
+template <typename S, std::size_t IDX>
+using meta_at_t = decltype(meta_t<S>{}.template member_at<IDX>());
+
+template <typename S, std::size_t IDX>
+using cold_slot_t = std::conditional_t<meta_at_t<S, IDX>::cold, std::tuple<typename meta_at_t<S, IDX>::value_t>,
+                                       std::tuple<>>;
+
+template <typename S, std::size_t... Is>
+auto values_of(std::index_sequence<Is...>) -> decltype(std::tuple_cat(std::declval<cold_slot_t<S, Is>>()...));
+
+// The position of the field IDX within the cold block
+template <typename S, std::size_t IDX, std::size_t... Is>
+constexpr std::size_t slot_of(std::index_sequence<Is...>) {
+  return (0 + ... + ((Is < IDX && meta_at_t<S, Is>::cold) ? 1 : 0));
+}
+
+}  // namespace cold_detail
+
+// Owns the out of line values of the cold fields of STRUCT_T
+//
+// The types are only computed within the member functions, as STRUCT_T is incomplete where the block is declared
+template <typename STRUCT_T>
+class cold_block {
+ public:
+  cold_block() = default;
+
+  cold_block(cold_block const& o) : data_(o.data_ == nullptr ? nullptr : new values_t<>(*o.values())) {}
+
+  cold_block(cold_block&& o) noexcept : data_(std::exchange(o.data_, nullptr)) {}
+
+  cold_block& operator=(cold_block const& o) {
+    if (this != &o) {
+      cold_block tmp{o};
+      std::swap(data_, tmp.data_);
+    }
+    return *this;
+  }
+
+  cold_block& operator=(cold_block&& o) noexcept {
+    std::swap(data_, o.data_);
+    return *this;
+  }
+
+  ~cold_block() { delete values(); }
+
+  // IDX is the index of the field within the struct
+  template <std::size_t IDX>
+  auto& get() {
+    if (data_ == nullptr) {
+      data_ = new values_t<>();
+    }
+    return std::get<slot<IDX>()>(*values());
+  }
+
+  template <std::size_t IDX>
+  auto const& get() const {
+    static const values_t<> defaults{};
+    return std::get<slot<IDX>()>(data_ == nullptr ? defaults : *values());
+  }
+
+  // True if the values were already allocated
+  bool allocated() const { return data_ != nullptr; }
+
+ private:
+  // An alias template, to delay the instantiation until STRUCT_T is complete
+  template <std::size_t DUMMY = 0>
+  using values_t = decltype(cold_detail::values_of<STRUCT_T>(
+      std::make_index_sequence<cold_detail::meta_t<STRUCT_T>{}.size()>()));
+
+  template <std::size_t IDX>
+  static constexpr std::size_t slot() {
+    return cold_detail::slot_of<STRUCT_T, IDX>(std::make_index_sequence<IDX>());
+  }
+
+  template <std::size_t DUMMY = 0>
+  values_t<DUMMY>* values() {
+    return static_cast<values_t<DUMMY>*>(data_);
+  }
+
+  template <std::size_t DUMMY = 0>
+  values_t<DUMMY> const* values() const {
+    return static_cast<values_t<DUMMY> const*>(data_);
+  }
+
+  void* data_ = nullptr;
+};
+
+}  // namespace tsar
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "tsar/detail/hash.hpp"
+#include "tsar/field.hpp"
+
+// Equality, ordering and hashing of TSAR_STRUCTs, generated from the struct metadata
+//
+//   tsar::equal(a, b);
+//   tsar::compare(a, b);  // lexicographic, in declaration order
+//   std::unordered_set<foo, tsar::struct_hash, tsar::struct_equal_to> set;
+//
+// Structs whose fields are integers, enums or pointers, without padding or other members between them, are
+// compared and hashed as a single block of bytes. Other structs are compared field by field.
+
+namespace tsar {
+
+namespace compare_detail {
+
+template <typename S, std::size_t IDX>
+using meta_at_t = decltype(S::meta().template member_at<IDX>());
+
+template <typename S, std::size_t... Is>
+constexpr bool bytewise_comparable(std::index_sequence<Is...>) {
+  using base_t = typename S::struct_t;
+  return (... && (!meta_at_t<S, Is>::cold && detail::bytewise_comparable_v<typename meta_at_t<S, Is>::value_t>)) &&
+         (0 + ... + sizeof(typename meta_at_t<S, Is>::value_t)) == sizeof(base_t);
+}
+
+template <typename S>
+inline constexpr bool bytewise_comparable_v = bytewise_comparable<S>(std::make_index_sequence<S::meta().size()>());
+
+template <typename S, std::size_t... Is>
+bool equal_impl(S const& a, S const& b, std::index_sequence<Is...>) {
+  if constexpr ((... && std::is_scalar_v<typename meta_at_t<S, Is>::value_t>)) {
+    return (... & (meta_at_t<S, Is>::access(a) == meta_at_t<S, Is>::access(b)));
+  } else {
+    return (... && (meta_at_t<S, Is>::access(a) == meta_at_t<S, Is>::access(b)));
+  }
+}
+
+template <typename S, std::size_t... Is>
+auto compare_impl(S const& a, S const& b, std::index_sequence<Is...>) {
+  std::common_comparison_category_t<std::compare_three_way_result_t<typename meta_at_t<S, Is>::value_t>...> ret =
+      std::strong_ordering::equal;
+  static_cast<void>((... || ((ret = meta_at_t<S, Is>::access(a) <=> meta_at_t<S, Is>::access(b)) != 0)));
+  return ret;
+}
+
+template <typename S, std::size_t... Is>
+std::size_t hash_impl(S const& s, std::index_sequence<Is...>) {
+  std::uint64_t ret = 0;
+  ((ret = detail::hash_combine(ret, std::hash<typename meta_at_t<S, Is>::value_t>{}(meta_at_t<S, Is>::access(s)))),
+   ...);
+  return ret;
+}
+
+}  // namespace compare_detail
+
+template <typename S>
+bool equal(S const& a, S const& b) {
+  if constexpr (compare_detail::bytewise_comparable_v<S>) {
+    return std::memcmp(&static_cast<typename S::struct_t const&>(a), &static_cast<typename S::struct_t const&>(b),
+                       sizeof(typename S::struct_t)) == 0;
+  } else {
+    return compare_detail::equal_impl(a, b, std::make_index_sequence<S::meta().size()>());
+  }
+}
+
+template <typename S>
+auto compare(S const& a, S const& b) {
+  return compare_detail::compare_impl(a, b, std::make_index_sequence<S::meta().size()>());
+}
+
+template <typename S>
+std::size_t hash_value(S const& s) {
+  if constexpr (compare_detail::bytewise_comparable_v<S>) {
+    return detail::hash_bytes(&static_cast<typename S::struct_t const&>(s), sizeof(typename S::struct_t));
+  } else {
+    return compare_detail::hash_impl(s, std::make_index_sequence<S::meta().size()>());
+  }
+}
+
+struct struct_equal_to {
+  template <typename S>
+  bool operator()(S const& a, S const& b) const {
+    return equal(a, b);
+  }
+};
+
+struct struct_hash {
+  template <typename S>
+  std::size_t operator()(S const& s) const {
+    return hash_value(s);
+  }
+};
+
+}  // namespace tsar
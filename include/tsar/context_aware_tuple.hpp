@@ -123,6 +123,8 @@ class context_aware_tuple_helper<MAPPING_T, TUPLE_T, std::index_sequence<Is...>,
 
   static_assert(sizeof(dummy_tuple_t) == sizeof(type),
                 "Member types have the same size regardless of the context parameter");
+  static_assert((... && (std::is_empty_v<T<context_aware_dummy<TUPLE_T>>> == std::is_empty_v<wrapper_type_for<T, Is>>)),
+                "Member types are empty regardless of the context parameter, empty members don't take up space");
 };
 
 template <typename MAPPING_T, template <typename> typename... T>
@@ -3,6 +3,10 @@
 
 #include <cstdint>
 #include <algorithm>
+#include <functional>
+#include <string_view>
+
+#include "tsar/detail/hash.hpp"
 
 namespace tsar {
 
@@ -22,6 +26,12 @@ struct cts {
 
   constexpr std::size_t size() const { return N; }
 
+  // Without the terminating null character
+  constexpr std::string_view view() const { return {str, N - 1}; }
+
+  // 64 bit FNV-1a hash of the view, equal to detail::hash_string of the same characters at runtime
+  constexpr std::uint64_t hash() const { return detail::hash_string(view()); }
+
   friend auto operator<=>(const cts&, const cts&) = default;
   friend bool operator==(const cts&, const cts&) = default;
 
@@ -29,4 +39,37 @@ struct cts {
 
 template<cts c> constexpr auto operator ""_s() { return c; }
 
+// Interned identity of a distinct cts value
+//
+// Every intern<C>() call with an equal C returns the same id, in every translation unit, so ids can be compared
+// and hashed as a single pointer instead of a string.
+class cts_id {
+ public:
+  constexpr std::string_view name() const { return *name_; }
+
+  friend constexpr bool operator==(cts_id, cts_id) = default;
+
+ private:
+  constexpr explicit cts_id(std::string_view const* name) : name_(name) {}
+
+  std::string_view const* name_;
+
+  template <cts C>
+  friend constexpr cts_id intern();
+  friend struct std::hash<cts_id>;
+};
+
+template <cts C>
+inline constexpr std::string_view interned_name = C.view();
+
+template <cts C>
+constexpr cts_id intern() {
+  return cts_id{&interned_name<C>};
+}
+
 }  // namespace tsar
+
+template <>
+struct std::hash<tsar::cts_id> {
+  std::size_t operator()(tsar::cts_id id) const { return std::hash<std::string_view const*>{}(id.name_); }
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+namespace tsar::detail {
+
+// 64 bit FNV-1a, usable both at compile time and at runtime
+constexpr std::uint64_t hash_string(std::string_view str, std::uint64_t seed = 0xcbf29ce484222325ull) {
+  std::uint64_t h = seed;
+  for (char c : str) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 0x100000001b3ull;
+  }
+  return h;
+}
+
+// splitmix64 finalizer: spreads every input bit to every output bit
+constexpr std::uint64_t hash_mix(std::uint64_t h) {
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ull;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebull;
+  h ^= h >> 31;
+  return h;
+}
+
+// Combines the hash of the next element into the seed
+constexpr std::uint64_t hash_combine(std::uint64_t seed, std::uint64_t h) {
+  return hash_mix(seed ^ (h + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+}
+
+// Types whose equality is the equality of their bytes, and whose bytes are all part of the value
+template <typename T>
+inline constexpr bool bytewise_comparable_v = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+// Hashes a raw byte block, 8 bytes at a time
+//
+// Only meaningful for objects with unique object representations (no padding, no floats)
+inline std::uint64_t hash_bytes(const void* data, std::size_t size, std::uint64_t seed = 0xcbf29ce484222325ull) {
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  std::uint64_t h = seed ^ size;
+  std::size_t i = 0;
+  for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+    std::uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(word));
+    h = hash_mix(h ^ word);
+  }
+  if (i < size) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, bytes + i, size - i);
+    h = hash_mix(h ^ word);
+  }
+  return h;
+}
+
+}  // namespace tsar::detail
@@ -2,6 +2,8 @@
 
 #include <array>
 #include <cstddef>
+#include <type_traits>
+#include <utility>
 
 #include "tsar/typewrap.hpp"
 
@@ -53,20 +55,48 @@ struct typelist_finder {
   }
 };
 
+// One entry of a named_mapping, the mapping inherits one of these for every key
+template <typename KEY, std::size_t I>
+struct key_entry {};
+
+template <typename SEQ, typename... KEYS>
+struct key_map;
+
+template <std::size_t... Is, typename... KEYS>
+struct key_map<std::index_sequence<Is...>, KEYS...> : key_entry<KEYS, Is>... {};
+
+// Deduces I from the derived to base conversion, without looking at the other keys. Deduction fails if the key
+// is missing, or if it's ambiguous because the key is present multiple times.
+template <typename KEY, std::size_t I>
+constexpr std::size_t key_index(key_entry<KEY, I> const* /* unused */) {
+  return I;
+}
+
+template <typename KEY, typename MAP>
+concept unique_key_of = requires(MAP const* map) { key_index<KEY>(map); };
+
 template <typename... KEYS>
 struct named_mapping {
   template <typename T>
   constexpr static auto index_for(T const& /* unused */) {
-    using t = typelist_finder<T, KEYS...>;
-    static_assert(t::contains(), "Type doesn't contain key");
-    static_assert(!t::has_multiple(), "Duplicate key encountered");
-    return index_for(int_t<t::index()>{});
+    if constexpr (unique_key_of<T, map_t>) {
+      return index_for(int_t<static_cast<int>(key_index<T>(static_cast<map_t const*>(nullptr)))>{});
+    } else {
+      // Only failed lookups scan the keys, for a precise diagnostic
+      using t = typelist_finder<T, KEYS...>;
+      static_assert(t::contains(), "Type doesn't contain key");
+      static_assert(!t::has_multiple(), "Duplicate key encountered");
+      return -1;
+    }
   }
 
   template <int I>
   constexpr static auto index_for(int_t<I> const& /* unused */) {
     return I;
   }
+
+ private:
+  using map_t = key_map<std::index_sequence_for<KEYS...>, KEYS...>;
 };
 
-}  // namespace tsar::detail
\ No newline at end of file
+}  // namespace tsar::detail
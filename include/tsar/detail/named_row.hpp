@@ -0,0 +1,17 @@
+#pragma once
+
+namespace tsar::detail {
+
+// A proxy object with named members, built from field_meta::named_member_t types
+template <typename... MEMBERS>
+struct named_row : public MEMBERS... {};
+
+// Allows returning a temporary named_row from operator->
+template <typename ROW_T>
+struct arrow_proxy {
+  ROW_T row;
+
+  ROW_T const* operator->() const { return &row; }
+};
+
+}  // namespace tsar::detail
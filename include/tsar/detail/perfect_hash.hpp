@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "tsar/detail/hash.hpp"
+
+// Perfect hash tables generated at compile time
+//
+// Uses the "hash, displace" scheme: keys are distributed into buckets based on
+// their hash, and every bucket gets a displacement value, which moves all keys of
+// the bucket to free slots of the table. Bigger buckets are placed first, as those
+// are the hardest to fit.
+//
+// Lookups require a single table access, and a final comparison of the key by the
+// caller, as keys not in the table also map to a (wrong) slot.
+//
+// The table works on 64 bit hashes of the keys, these have to be unique.
+
+namespace tsar::detail {
+
+template <std::size_t N>
+struct perfect_hash {
+  static constexpr std::size_t bucket_count = std::bit_ceil(N == 0 ? std::size_t{1} : N);
+  static constexpr std::size_t table_size = bucket_count * 2;
+  static constexpr std::size_t empty = N;
+
+  std::array<std::uint32_t, bucket_count> displacements{};
+  std::array<std::size_t, table_size> slots{};
+
+  static constexpr std::size_t bucket_for(std::uint64_t hash) {
+    if constexpr (bucket_count == 1) {
+      return 0;
+    } else {
+      return hash_mix(hash) >> (64 - std::countr_zero(bucket_count));
+    }
+  }
+
+  static constexpr std::size_t slot_for(std::uint64_t hash, std::uint32_t displacement) {
+    return hash_mix(hash + displacement * 0x9e3779b97f4a7c15ull) & (table_size - 1);
+  }
+
+  // Returns the index of the only key which can have this hash, or N
+  constexpr std::size_t find(std::uint64_t hash) const {
+    return slots[slot_for(hash, displacements[bucket_for(hash)])];
+  }
+};
+
+template <std::size_t N>
+constexpr perfect_hash<N> make_perfect_hash(std::array<std::uint64_t, N> const& hashes) {
+  using ph_t = perfect_hash<N>;
+  ph_t ret;
+
+  for (auto& s : ret.slots) {
+    s = ph_t::empty;
+  }
+
+  for (std::size_t i = 0; i < N; ++i) {
+    for (std::size_t j = i + 1; j < N; ++j) {
+      if (hashes[i] == hashes[j]) {
+        throw std::logic_error("perfect_hash: duplicate key");
+      }
+    }
+  }
+
+  // keys ordered by bucket (counting sort)
+  std::array<std::size_t, ph_t::bucket_count + 1> bucket_start{};
+  for (std::size_t i = 0; i < N; ++i) {
+    bucket_start[ph_t::bucket_for(hashes[i]) + 1]++;
+  }
+  std::size_t largest_bucket = 0;
+  for (std::size_t b = 0; b < ph_t::bucket_count; ++b) {
+    largest_bucket = bucket_start[b + 1] > largest_bucket ? bucket_start[b + 1] : largest_bucket;
+    bucket_start[b + 1] += bucket_start[b];
+  }
+  std::array<std::size_t, N> keys{};
+  std::array<std::size_t, ph_t::bucket_count> fill{};
+  for (std::size_t i = 0; i < N; ++i) {
+    const std::size_t b = ph_t::bucket_for(hashes[i]);
+    keys[bucket_start[b] + fill[b]++] = i;
+  }
+
+  std::array<std::size_t, N> candidate{};
+  for (std::size_t bucket_size = largest_bucket; bucket_size > 0; --bucket_size) {
+    for (std::size_t b = 0; b < ph_t::bucket_count; ++b) {
+      if (bucket_start[b + 1] - bucket_start[b] != bucket_size) {
+        continue;
+      }
+
+      std::uint32_t d = 0;
+      for (;; ++d) {
+        if (d == (1u << 24)) {
+          throw std::logic_error("perfect_hash: no displacement found");
+        }
+        bool fits = true;
+        for (std::size_t k = 0; k < bucket_size && fits; ++k) {
+          candidate[k] = ph_t::slot_for(hashes[keys[bucket_start[b] + k]], d);
+          fits = ret.slots[candidate[k]] == ph_t::empty;
+          for (std::size_t l = 0; l < k && fits; ++l) {
+            fits = candidate[l] != candidate[k];
+          }
+        }
+        if (fits) {
+          break;
+        }
+      }
+
+      ret.displacements[b] = d;
+      for (std::size_t k = 0; k < bucket_size; ++k) {
+        ret.slots[candidate[k]] = keys[bucket_start[b] + k];
+      }
+    }
+  }
+
+  return ret;
+}
+
+}  // namespace tsar::detail
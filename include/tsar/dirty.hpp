@@ -0,0 +1,79 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <utility>
+
+#include "tsar/field.hpp"
+
+// Opt-in tracking of modified fields
+//
+// TSAR_STRUCT(foo) {
+//   TSAR_FIELD(int, a);
+//   TSAR_FIELD(float, b);
+//
+//   TSAR_DIRTY_TRACKING(); // has to come after the last field
+// };
+//
+// Assignments, compound assignments, increments and decrements through the fields
+// (f.a = 4, f.a += 4, ++f.a) set the bit of the field in f.tsar_dirty.
+// Modifications through references (int& r = f.a; r = 4) or mutating member functions
+// (f.s.append("x")) aren't tracked, these have to be marked manually with f.tsar_dirty.mark<IDX>().
+//
+// for_each_dirty visits only the modified fields:
+//   tsar::for_each_dirty(f, [](auto meta, auto& value) { ... meta.name_view() ... });
+//   f.tsar_dirty.clear();
+
+// The size of the bitset is the number of fields declared before the macro
+#define TSAR_DIRTY_TRACKING() tsar::dirty_bits<tsar::list::size(tsar_struct_head{}, []() {})> tsar_dirty
+
+namespace tsar {
+
+template <std::size_t N>
+class dirty_bits {
+ public:
+  template <std::size_t IDX>
+  void mark() {
+    static_assert(IDX < N, "TSAR_DIRTY_TRACKING() has to be placed after the last TSAR_FIELD");
+    bits_.set(IDX);
+  }
+
+  void mark_all() { bits_.set(); }
+
+  bool test(std::size_t idx) const { return bits_.test(idx); }
+  bool any() const { return bits_.any(); }
+  std::size_t count() const { return bits_.count(); }
+
+  void clear() { bits_.reset(); }
+  void clear(std::size_t idx) { bits_.reset(idx); }
+
+  static constexpr std::size_t size() { return N; }
+
+ private:
+  std::bitset<N> bits_;
+};
+
+namespace dirty_detail {
+
+template <typename S, typename F, std::size_t... Is>
+void for_each_dirty_impl(S& obj, F&& f, std::index_sequence<Is...>) {
+  (
+      [&]() {
+        if (obj.tsar_dirty.test(Is)) {
+          constexpr auto meta = S::meta().template member_at<Is>();
+          f(meta, meta.access(obj));
+        }
+      }(),
+      ...);
+}
+
+}  // namespace dirty_detail
+
+// Calls f(field_meta, value) for every modified field, in declaration order
+template <typename S, typename F>
+void for_each_dirty(S& obj, F&& f) {
+  static_assert(dirty_tracked<S>, "for_each_dirty requires TSAR_DIRTY_TRACKING() in the struct");
+  dirty_detail::for_each_dirty_impl(obj, std::forward<F>(f), std::make_index_sequence<S::meta().size()>());
+}
+
+}  // namespace tsar
@@ -1,14 +1,21 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 
 #include "tsar/compiler_support.hpp"
 
 #include "tsar/cts.hpp"
+#include "tsar/detail/hash.hpp"
+#include "tsar/detail/perfect_hash.hpp"
 #include "tsar/list.hpp"
+#include "tsar/typesort.hpp"
 
 namespace tsar {
 
@@ -20,7 +27,11 @@ namespace tsar {
 // To fix this:
 // a. we have to return something template-ish, to delay instantiation until it's first used
 // b. we have to use an auto lamdda, as that somehow isn't included in the "no templates" restriction
-#define TSAR_FIELD_V(real_type, value_type, name, ...)                 \
+//
+// named_member uses the same trick to generate a struct with a single member called `name`, of the type wrapped
+// by the type_identity it receives. Containers (like soa_vector) use it to hand out proxies with the same member names
+// as the original struct.
+#define TSAR_FIELD_OFFSET(name)                                        \
   struct name##_offset_o {                                             \
     static TSAR_CONSTEVAL auto get() {                                      \
       return [](auto* T) {                                             \
@@ -31,7 +42,19 @@ namespace tsar {
         _Pragma("GCC diagnostic pop") \
       };                                                               \
     }                                                                  \
-  };                                                                   \
+    static TSAR_CONSTEVAL auto named_member() {                        \
+      return [](auto* tsar_m) {                                        \
+        using tsar_mt = typename std::remove_pointer_t<decltype(tsar_m)>::type; \
+        struct named_member_t {                                        \
+          tsar_mt name;                                                \
+        };                                                             \
+        return static_cast<named_member_t*>(nullptr);                  \
+      };                                                               \
+    }                                                                  \
+  }
+
+#define TSAR_FIELD_V(real_type, value_type, name, ...)                                                   \
+  TSAR_FIELD_OFFSET(name);                                                                               \
   using tsar_##name = real_type<struct_t, value_type, #name, name##_offset_o __VA_OPT__(, ) __VA_ARGS__>; \
   tsar_##name name
 
@@ -43,6 +66,24 @@ namespace tsar {
 // TODO: make field_wrap customizable!
 #define TSAR_FIELD_T(type, name, ...) TSAR_FIELD_V(tsar::tsar_field_wrap_t, type, name, __VA_OPT__(, ) __VA_ARGS__)
 
+// Starts a new cache line group: the field is aligned to a cache line, the following fields share its line(s)
+// until the next TSAR_CACHE_LINE_FIELD. As the struct itself becomes cache line aligned, the last group
+// doesn't share its line with neighbouring objects either.
+// Fields written by different threads should start different groups, to avoid false sharing.
+#define TSAR_CACHE_LINE_FIELD(type, name)                                              \
+  TSAR_FIELD_OFFSET(name);                                                             \
+  using tsar_##name = tsar::tsar_field_wrap<struct_t, type, #name, name##_offset_o>; \
+  alignas(tsar::cache_line_size) tsar_##name name
+
+// Cold fields are stored out of line, in a separately allocated block shared by every cold field of the struct.
+// The field itself is empty, and doesn't take up space in the struct.
+// Cold fields can't have initializers, they are value initialized.
+// Structs with cold fields require TSAR_COLD_STORAGE(), see cold.hpp.
+#define TSAR_COLD_FIELD(type, name)                                           \
+  TSAR_FIELD_OFFSET(name);                                                    \
+  using tsar_##name = tsar::tsar_cold_field_wrap<struct_t, type, #name, name##_offset_o>; \
+  [[no_unique_address]] tsar_##name name
+
 #define TSAR_STRUCT(name)                           \
   struct name##_base;                               \
   using name = tsar::tsar_struct_wrap<name##_base>; \
@@ -53,6 +94,55 @@ namespace tsar {
   using name = wrap<name##_base>; \
   struct name##_base : public tsar::tsar_struct_base<name##_base, tsar::cts{#name}, wrap> __VA_OPT__(,) __VA_ARGS__
 
+// Compound assignments, increments and decrements of the field wraps, which also mark the field dirty
+// ACCESS is the stored value, RET the reference returned by the assignments
+#define TSAR_FIELD_COMPOUND_ASSIGNMENT(op, ACCESS, RET)                                         \
+  template <typename U>                                                                         \
+    requires requires(value_t& tsar_v, U&& tsar_u) { tsar_v op std::forward<U>(tsar_u); }       \
+  auto& operator op(U&& o) {                                                                    \
+    ACCESS op std::forward<U>(o);                                                               \
+    mark_dirty();                                                                               \
+    return RET;                                                                                 \
+  }                                                                                             \
+  /* braced lists can't be deduced as U, e.g. name += {'a', 'b'} */                             \
+  template <typename E>                                                                         \
+    requires requires(value_t& tsar_v, std::initializer_list<E> tsar_il) { tsar_v op tsar_il; } \
+  auto& operator op(std::initializer_list<E> il) {                                              \
+    ACCESS op il;                                                                               \
+    mark_dirty();                                                                               \
+    return RET;                                                                                 \
+  }
+
+#define TSAR_FIELD_INCREMENT(op, ACCESS, RET)          \
+  auto& operator op()                                  \
+    requires requires(value_t& tsar_v) { op tsar_v; }  \
+  {                                                    \
+    op ACCESS;                                         \
+    mark_dirty();                                      \
+    return RET;                                        \
+  }                                                    \
+  auto operator op(int)                                \
+    requires requires(value_t& tsar_v) { tsar_v op; }  \
+  {                                                    \
+    auto tsar_old = ACCESS op;                         \
+    mark_dirty();                                      \
+    return tsar_old;                                   \
+  }
+
+#define TSAR_FIELD_MODIFIERS(ACCESS, RET)                \
+  TSAR_FIELD_COMPOUND_ASSIGNMENT(+=, ACCESS, RET)        \
+  TSAR_FIELD_COMPOUND_ASSIGNMENT(-=, ACCESS, RET)        \
+  TSAR_FIELD_COMPOUND_ASSIGNMENT(*=, ACCESS, RET)        \
+  TSAR_FIELD_COMPOUND_ASSIGNMENT(/=, ACCESS, RET)        \
+  TSAR_FIELD_COMPOUND_ASSIGNMENT(%=, ACCESS, RET)        \
+  TSAR_FIELD_COMPOUND_ASSIGNMENT(&=, ACCESS, RET)        \
+  TSAR_FIELD_COMPOUND_ASSIGNMENT(|=, ACCESS, RET)        \
+  TSAR_FIELD_COMPOUND_ASSIGNMENT(^=, ACCESS, RET)        \
+  TSAR_FIELD_COMPOUND_ASSIGNMENT(<<=, ACCESS, RET)       \
+  TSAR_FIELD_COMPOUND_ASSIGNMENT(>>=, ACCESS, RET)       \
+  TSAR_FIELD_INCREMENT(++, ACCESS, RET)                  \
+  TSAR_FIELD_INCREMENT(--, ACCESS, RET)
+
 #define TSAR_PROTECTED_COPY_AND_MOVE(T) \
  protected:                             \
   T(T const&) = default;                \
@@ -69,11 +159,50 @@ namespace tsar {
   T& operator=(T const&) = delete;   \
   T& operator=(T&&) = delete;
 
+// The TSAR_FIELD_OFFSET helper of a field wrap, deduced from its template arguments
+//
+// Wraps can't name it in a member: with a function local struct, that crashes GCC 12 while generating debug info.
+template <typename FIELD_WRAP_T>
+struct field_offset_helper;
+
+template <template <typename, typename, auto, typename> typename WRAP_T, typename STRUCT_T, typename TYPE_T, auto NAME,
+          typename OFFSET>
+struct field_offset_helper<WRAP_T<STRUCT_T, TYPE_T, NAME, OFFSET>> {
+  using type = OFFSET;
+};
+
+template <template <typename, template <typename> typename, auto, typename> typename WRAP_T, typename STRUCT_T,
+          template <typename> typename TYPE_T, auto NAME, typename OFFSET>
+struct field_offset_helper<WRAP_T<STRUCT_T, TYPE_T, NAME, OFFSET>> {
+  using type = OFFSET;
+};
+
 template <typename ST_META_T, typename FIELD_WRAP_T, cts FIELD_NAME>
 struct field_meta {
+  using wrap_t = FIELD_WRAP_T;
+  using value_t = typename FIELD_WRAP_T::value_t;
+
+  // Cold fields aren't stored at their offset, but in the cold block of the struct
+  static constexpr bool cold = requires { FIELD_WRAP_T::tsar_cold; };
+
+  // A struct with a single member named after the field, with the type MEMBER_T
+  template <typename MEMBER_T>
+  using named_member_t = std::remove_pointer_t<decltype(field_offset_helper<FIELD_WRAP_T>::type::named_member()(
+      static_cast<std::type_identity<MEMBER_T>*>(nullptr)))>;
+
   TSAR_CONSTEVAL auto name() const { return FIELD_NAME; }
+  static constexpr std::string_view name_view() { return FIELD_NAME.view(); }
   TSAR_CONSTEVAL auto offset() const { return FIELD_WRAP_T::offset(); }
   TSAR_CONSTEVAL auto type() const { return static_cast<typename FIELD_WRAP_T::value_t*>(nullptr); }
+
+  // Returns the value of this field within an instance of the (wrapped) struct
+  static value_t& access(ST_META_T& t) {
+    return *reinterpret_cast<FIELD_WRAP_T*>(reinterpret_cast<char*>(&t) + FIELD_WRAP_T::offset());
+  }
+
+  static value_t const& access(ST_META_T const& t) {
+    return *reinterpret_cast<const FIELD_WRAP_T*>(reinterpret_cast<const char*>(&t) + FIELD_WRAP_T::offset());
+  }
 };
 
 template <typename T, cts NAME>
@@ -82,17 +211,50 @@ struct struct_meta {
 
   TSAR_CONSTEVAL auto name() const { return NAME; }
 
-  TSAR_CONSTEVAL std::size_t size() const {
-    return list::size(typename T::tsar_struct_head{}, []() {});
-  }
+  TSAR_CONSTEVAL std::size_t size() const { return fields.size(); }
 
   template <std::size_t IDX>
   TSAR_CONSTEVAL auto member_at() const {
-    using item_t = std::remove_pointer_t<decltype(list::at<typename T::tsar_struct_head, IDX, []() {}>())>;
+    using item_t = std::remove_pointer_t<decltype(fields.template at<IDX>())>;
     return item_t::tsar_meta();
   }
+
+  // Returns the index of the field with the given name
+  // Uses a perfect hash table generated at compile time, so the cost doesn't depend on the number of fields
+  constexpr std::optional<std::size_t> find(std::string_view name) const {
+    using lookup_t = decltype(name_lookup(std::make_index_sequence<struct_meta{}.size()>()));
+    const std::size_t idx = lookup_t::table.find(detail::hash_string(name));
+    if (idx < lookup_t::names.size() && lookup_t::names[idx] == name) {
+      return idx;
+    }
+    return std::nullopt;
+  }
+
+ private:
+  template <std::size_t... Is>
+  struct name_lookup_t {
+    static constexpr std::array<std::string_view, sizeof...(Is)> names = {
+        decltype(struct_meta{}.template member_at<Is>())::name_view()...};
+    static constexpr auto table =
+        detail::make_perfect_hash<sizeof...(Is)>({detail::hash_string(names[Is])...});
+  };
+
+  template <std::size_t... Is>
+  static name_lookup_t<Is...> name_lookup(std::index_sequence<Is...>);
+
+  // Snapshot of the fields, taken at the first metadata query, after the struct is complete.
+  // Every later query indexes the snapshot, instead of searching the stateful list again.
+  static constexpr auto fields = list::freeze<typename T::tsar_struct_head>();
 };
 
+// Structs containing TSAR_DIRTY_TRACKING() record assignments through their fields, see dirty.hpp
+template <typename T>
+concept dirty_tracked = requires(T& t) { t.tsar_dirty; };
+
+// Structs containing TSAR_COLD_STORAGE() can have cold fields, see cold.hpp
+template <typename T>
+concept has_cold_storage = requires(T& t) { t.tsar_cold; };
+
 template <typename T, tsar::cts NAME, template <typename> typename WRAP_T>
 struct tsar_struct_base {
   using struct_t = T;
@@ -132,9 +294,12 @@ struct tsar_field_wrap_composition {
 
   TYPE_T& operator=(TYPE_T const& o) {
     t = o;
+    mark_dirty();
     return t;
   }
 
+  TSAR_FIELD_MODIFIERS(t, t)
+
   operator TYPE_T&() { return t; }
 
   operator TYPE_T const &() const { return t; }
@@ -142,10 +307,16 @@ struct tsar_field_wrap_composition {
   enclosing_t& enclosing() { return *reinterpret_cast<enclosing_t*>(reinterpret_cast<char*>(this) - offset()); }
 
   enclosing_t const& enclosing() const {
-    return *reinterpret_cast<const enclosing_t*>(reinterpret_cast<const char*>(&this) - offset());
+    return *reinterpret_cast<const enclosing_t*>(reinterpret_cast<const char*>(this) - offset());
   }
 
  private:
+  void mark_dirty() {
+    if constexpr (dirty_tracked<STRUCT_T>) {
+      enclosing().tsar_dirty.template mark<decltype(tsar_link)::idx>();
+    }
+  }
+
   // Try to keep these fields within the struct itself
 
   tsar_field_wrap_composition(tsar_field_wrap_composition const&) = default;
@@ -172,9 +343,12 @@ struct tsar_field_wrap_inheritance : public TYPE_T {
   template <typename... Args>
   tsar_field_wrap_inheritance& operator=(Args&&... args) {
     TYPE_T::operator=(std::forward<Args>(args)...);
+    mark_dirty();
     return *this;
   }
 
+  TSAR_FIELD_MODIFIERS(static_cast<value_t&>(*this), *this)
+
 
   static TSAR_CONSTEVAL field_meta<STRUCT_T, tsar_field_wrap_inheritance, cts<NAME.size()>{NAME}> tsar_meta() { return {}; }
 
@@ -185,10 +359,16 @@ struct tsar_field_wrap_inheritance : public TYPE_T {
   enclosing_t& enclosing() { return *reinterpret_cast<enclosing_t*>(reinterpret_cast<char*>(this) - offset()); }
 
   enclosing_t const& enclosing() const {
-    return *reinterpret_cast<const enclosing_t*>(reinterpret_cast<const char*>(&this) - offset());
+    return *reinterpret_cast<const enclosing_t*>(reinterpret_cast<const char*>(this) - offset());
   }
 
  private:
+  void mark_dirty() {
+    if constexpr (dirty_tracked<STRUCT_T>) {
+      enclosing().tsar_dirty.template mark<decltype(tsar_link)::idx>();
+    }
+  }
+
   // Try to keep these fields within the struct itself
 
   tsar_field_wrap_inheritance(tsar_field_wrap_inheritance const&) = default;
@@ -219,7 +399,7 @@ struct wrap_magic {
   STRUCT_T& enclosing() { return *reinterpret_cast<STRUCT_T*>(reinterpret_cast<char*>(this) - offset()); }
 
   STRUCT_T const& enclosing() const {
-    return *reinterpret_cast<const STRUCT_T*>(reinterpret_cast<const char*>(&this) - offset());
+    return *reinterpret_cast<const STRUCT_T*>(reinterpret_cast<const char*>(this) - offset());
   }
 
   friend STRUCT_T;
@@ -254,16 +434,25 @@ struct tsar_field_wrap_t : public TYPE_T<wrap_magic<STRUCT_T, OFFSET>> {
   enclosing_t& enclosing() { return *reinterpret_cast<enclosing_t*>(reinterpret_cast<char*>(this) - offset()); }
 
   enclosing_t const& enclosing() const {
-    return *reinterpret_cast<const enclosing_t*>(reinterpret_cast<const char*>(&this) - offset());
+    return *reinterpret_cast<const enclosing_t*>(reinterpret_cast<const char*>(this) - offset());
   }
 
   template <typename... Args>
   tsar_field_wrap_t& operator=(Args&&... args) {
     value_t::operator=(std::forward<Args>(args)...);
+    mark_dirty();
     return *this;
   }
 
+  TSAR_FIELD_MODIFIERS(static_cast<value_t&>(*this), *this)
+
  private:
+  void mark_dirty() {
+    if constexpr (dirty_tracked<STRUCT_T>) {
+      enclosing().tsar_dirty.template mark<decltype(tsar_link)::idx>();
+    }
+  }
+
   // Try to keep these fields within the struct itself
   // The best way to do it is by disallowing construction from the outside
 
@@ -282,7 +471,78 @@ struct tsar_field_wrap_t : public TYPE_T<wrap_magic<STRUCT_T, OFFSET>> {
   friend STRUCT_T;
 };
 
+template <typename STRUCT_T, typename TYPE_T, tsar::cts NAME, typename OFFSET>
+struct tsar_cold_field_wrap {
+  using value_t = TYPE_T;
+  using enclosing_t = STRUCT_T;
+
+  static constexpr bool tsar_cold = true;
+
+  [[no_unique_address]] tsar::list::link<typename STRUCT_T::tsar_struct_head, tsar_cold_field_wrap> tsar_link;
+
+  static TSAR_CONSTEVAL field_meta<STRUCT_T, tsar_cold_field_wrap, cts<NAME.size()>{NAME}> tsar_meta() { return {}; }
+
+  static const TSAR_CONSTEVAL std::size_t offset() { return OFFSET::get()(static_cast<STRUCT_T*>(nullptr)); }
+
+  tsar_cold_field_wrap() = default;
+
+  TYPE_T& get() { return cold_block().template get<decltype(tsar_link)::idx>(); }
+  TYPE_T const& get() const { return cold_block().template get<decltype(tsar_link)::idx>(); }
+
+  TYPE_T& operator=(TYPE_T const& o) {
+    get() = o;
+    mark_dirty();
+    return get();
+  }
+
+  TSAR_FIELD_MODIFIERS(get(), get())
+
+  operator TYPE_T&() { return get(); }
+
+  operator TYPE_T const &() const { return get(); }
+
+  TYPE_T* operator->() { return &get(); }
+  TYPE_T const* operator->() const { return &get(); }
+
+  enclosing_t& enclosing() { return *reinterpret_cast<enclosing_t*>(reinterpret_cast<char*>(this) - offset()); }
+
+  enclosing_t const& enclosing() const {
+    return *reinterpret_cast<const enclosing_t*>(reinterpret_cast<const char*>(this) - offset());
+  }
+
+ private:
+  auto& cold_block() {
+    static_assert(has_cold_storage<STRUCT_T>, "TSAR_COLD_FIELD requires TSAR_COLD_STORAGE() in the struct");
+    return enclosing().tsar_cold;
+  }
+
+  auto const& cold_block() const {
+    static_assert(has_cold_storage<STRUCT_T>, "TSAR_COLD_FIELD requires TSAR_COLD_STORAGE() in the struct");
+    return enclosing().tsar_cold;
+  }
+
+  void mark_dirty() {
+    if constexpr (dirty_tracked<STRUCT_T>) {
+      enclosing().tsar_dirty.template mark<decltype(tsar_link)::idx>();
+    }
+  }
+
+  // Copying the struct copies the cold block, the field itself is stateless
+
+  tsar_cold_field_wrap(tsar_cold_field_wrap const&) = default;
+  tsar_cold_field_wrap(tsar_cold_field_wrap&&) = default;
+
+  tsar_cold_field_wrap& operator=(tsar_cold_field_wrap const&) = default;
+  tsar_cold_field_wrap& operator=(tsar_cold_field_wrap&&) = default;
+
+  friend STRUCT_T;
+};
+
 template <typename STRUCT_T, typename TYPE_T, tsar::cts NAME, typename OFFSET>
 using tsar_field_wrap = typename tsar_field_wrap_helper<STRUCT_T, TYPE_T, cts<NAME.size()>(NAME), OFFSET>::type;
 
 }  // namespace tsar
+
+#undef TSAR_FIELD_MODIFIERS
+#undef TSAR_FIELD_INCREMENT
+#undef TSAR_FIELD_COMPOUND_ASSIGNMENT
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <cstdlib>
+#include <type_traits>
 #include <utility>
 
 #include "tsar/log_search.hpp"
@@ -58,7 +59,11 @@ TSAR_CONSTEVAL bool nth_exists(float) {
 template <typename L, typename Id>
 TSAR_CONSTEVAL std::size_t size(L, Id) {
   // TODO: why I have to specify the parameter here?
-  auto l = []<std::size_t Idx, typename Id2>() { return nth_exists<L, Idx, Id2>(0); };
+  // The probe is a requires expression instead of nth_exists: it avoids instantiating (and overload resolving)
+  // two function templates for every step of the search
+  auto l = []<std::size_t Idx, typename Id2>() {
+    return requires { get_nth(typename head<L>::template index<Idx>{}, Id2{}); };
+  };
   return log_search_v<decltype(l), Id>();
 }
 
@@ -132,8 +137,8 @@ TSAR_CONSTEVAL bool has_prev() {
 
 template <typename LL, typename Curr, auto Id = []() {}>
 TSAR_CONSTEVAL bool has_next() {
-  // TODO: this could be optimized ...
-  return static_cast<long long int>(index_of<LL, Curr, Id>()) < static_cast<long long int>(size(LL{}, Id)) - 1;
+  // A single probe of the next index, instead of searching for the size of the list
+  return nth_exists<LL, static_cast<std::size_t>(index_of<LL, Curr, Id>() + 1), decltype(Id)>(0);
 }
 
 ///////////////////////////////////////////
@@ -151,6 +156,46 @@ constexpr auto for_each(F f = {}) {
   return for_each_impl<L, F, Id>(f, Indices{});
 }
 
+///////////////////////////////////////////
+// Frozen lists
+//
+// freeze<L>() takes a snapshot of the size of the list at the point of the call.
+// Items below that size never change, so queries on the snapshot use a single, fixed Id instead of a fresh lambda:
+// they don't search, and their results are cached by the compiler like with any other template.
+// A snapshot should be taken once (e.g. into a constexpr variable) when the same list is queried repeatedly.
+//
+// Items are still looked up with the O(1) injected get_nth functions: indexing a type pack (e.g. with indexed
+// inheritance) would cost O(N) per lookup without compiler builtins.
+
+struct frozen_id {};
+
+template <typename L, std::size_t N>
+struct frozen {
+  static TSAR_CONSTEVAL std::size_t size() { return N; }
+
+  // Same as list::at, returns a pointer to the item
+  template <std::size_t Idx>
+  static TSAR_CONSTEVAL auto at() {
+    static_assert(Idx < N, "Overindexing a frozen list");
+    return get_nth(typename head<L>::template index<Idx>{}, frozen_id{});
+  }
+
+  // Same as list::for_each, calls f with pointers to every item
+  template <typename F>
+  static constexpr auto for_each(F f = {}) {
+    return for_each_impl(f, std::make_index_sequence<N>());
+  }
 
+ private:
+  template <typename F, std::size_t... Is>
+  static constexpr auto for_each_impl(F f, std::index_sequence<Is...>) {
+    return f(at<Is>()...);
+  }
+};
+
+template <typename L, auto Id = []() {}>
+TSAR_CONSTEVAL auto freeze() {
+  return frozen<L, size(L{}, Id)>{};
+}
 
 }  // namespace tsar::list
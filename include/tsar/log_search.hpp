@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdlib>
 #include <type_traits>
 
@@ -39,6 +40,12 @@ consteval std::size_t log_search_v(Lookup const& l = Lookup{}, Id* i = nullptr);
 // Simplified version which only requires a lambda
 template <typename Lookup, auto Id = []() {}>
 consteval std::size_t log_search(Lookup const& l = Lookup{});
+
+// Runtime counterpart: returns the index of the first item of the sorted array which isn't less than value, or N
+//
+// Branchless: the number of steps only depends on N, and every step is a conditional move instead of a jump.
+template <typename T, std::size_t N, typename U>
+constexpr std::size_t log_search_sorted(std::array<T, N> const& items, U const& value);
 }  // namespace tsar
 
 // Implementation
@@ -74,16 +81,17 @@ consteval bool do_lookup() {
 // Helper: jumps upwards until the condition is met
 // ====================================
 // Returns the last POW level (index for the pow2 template) which mets the condition
+//
+// The steps use if constexpr instead of SFINAE overloads: a step only instantiates the lookup, and the next step,
+// without overload resolution between two candidates.
 
 template <typename Lookup, std::size_t Curr_idx, std::size_t Pow_level, typename Id>
-consteval std::size_t log_up_check(float) {
-  return Pow_level;
-}
-
-template <typename Lookup, std::size_t Curr_idx, std::size_t Pow_level, typename Id,
-          typename = std::enable_if_t<do_lookup<Lookup, pow2<Pow_level + 1>, Id>()>>
 consteval std::size_t log_up_check(int) {
-  return log_up_check<Lookup, pow2<Pow_level + 1>, Pow_level + 1, Id>(0);
+  if constexpr (do_lookup<Lookup, pow2<Pow_level + 1>, Id>()) {
+    return log_up_check<Lookup, pow2<Pow_level + 1>, Pow_level + 1, Id>(0);
+  } else {
+    return Pow_level;
+  }
 }
 
 // Helper: return the middle of a range
@@ -99,23 +107,12 @@ consteval std::size_t log_in_middle() {
 // Returns the actual index of the last matching value
 
 template <typename Lookup, std::size_t Start_idx, std::size_t End_idx, typename Id>
-consteval std::size_t log_in_check(float);
-
-template <typename Lookup, std::size_t Start_idx, std::size_t End_idx, typename Id,
-          typename = std::enable_if_t<do_lookup<Lookup, log_in_middle<Start_idx, End_idx>(), Id>()>>
 consteval std::size_t log_in_check(int) {
   if constexpr (Start_idx + 1 == End_idx) {
     return Start_idx;
-  } else {
+  } else if constexpr (do_lookup<Lookup, log_in_middle<Start_idx, End_idx>(), Id>()) {
     // the middle exists -> it should be larger
     return log_in_check<Lookup, log_in_middle<Start_idx, End_idx>(), End_idx, Id>(0);
-  }
-}
-
-template <typename Lookup, std::size_t Start_idx, std::size_t End_idx, typename Id>
-consteval std::size_t log_in_check(float) {
-  if constexpr (Start_idx + 1 == End_idx) {
-    return Start_idx;
   } else {
     // the middle doesn't exists -> it should be smaller
     return log_in_check<Lookup, Start_idx, log_in_middle<Start_idx, End_idx>(), Id>(0);
@@ -149,4 +146,20 @@ consteval std::size_t log_search(Lookup const& l) {
   return log_search_v(l, static_cast<decltype(Id)*>(nullptr));
 }
 
+template <typename T, std::size_t N, typename U>
+constexpr std::size_t log_search_sorted(std::array<T, N> const& items, U const& value) {
+  if constexpr (N == 0) {
+    return 0;
+  } else {
+    std::size_t base = 0;
+    std::size_t len = N;
+    while (len > 1) {
+      const std::size_t half = len / 2;
+      base = items[base + half] < value ? base + half : base;
+      len -= half;
+    }
+    return base + (items[base] < value);
+  }
+}
+
 }  // namespace tsar
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tsar/observable/observer_registry.hpp"
+
+namespace tsar::observable {
+
+// An observer registry which allows firing from multiple threads, concurrently with observe / unobserve
+//
+// Can be used in place of observer_registry:
+//   tsar::cat{}.add<concurrent_observer_registry>(observer_registry_marker{})
+//
+// The observer lists are immutable snapshots, fire reads the current snapshot without locking (RCU style).
+// observe / unobserve copy the snapshot under a writer lock, and publish the new version.
+// Old snapshots are reclaimed after a grace period: every write waits until each fire that could still
+// see the previous snapshot completes, so at most one snapshot is live between writes, and the observer
+// can be destroyed right after unobserve returns.
+//
+// Limitations:
+// * observers must not call observe / unobserve on the same registry from on_changed
+// * batching (begin_batch) isn't supported
+// * the observable values themselves aren't synchronized, each item should have a single writer at a time
+template <typename CTX>
+class concurrent_observer_registry {
+ public:
+  concurrent_observer_registry() : snapshot_(new snapshot_t{}) {}
+
+  ~concurrent_observer_registry() {
+    delete snapshot_.load();
+  }
+
+  concurrent_observer_registry(concurrent_observer_registry const&) = delete;
+  concurrent_observer_registry(concurrent_observer_registry&&) = delete;
+  concurrent_observer_registry& operator=(concurrent_observer_registry const&) = delete;
+  concurrent_observer_registry& operator=(concurrent_observer_registry&&) = delete;
+
+  template <size_t IDX, typename T>
+  void fire(T& item_ref) {
+    read_guard guard{*this};
+    snapshot_t const& observers = *snapshot_.load();
+    if (IDX >= observers.size()) {
+      return;
+    }
+    for (void* observer : observers[IDX]) {
+      static_cast<observer_t<T>*>(observer)->on_changed(item_ref);
+    }
+  }
+
+  template <size_t DUMMY>
+  constexpr static size_t observable_increment() {
+    // the registry itself can't be observed, it doesn't need a slot
+    return 0;
+  }
+
+  constexpr static size_t observable_offset() {
+    return sum_counter<CTX::idx, typename CTX::tuple_t::std_tuple_t>::sum();
+  }
+
+  template <size_t IDX, typename T>
+  void observe(observer_t<T>& observer) {
+    std::lock_guard<std::mutex> lock{write_mutex_};
+    auto* next = new snapshot_t{*snapshot_.load()};
+    if (IDX >= next->size()) {
+      next->resize(IDX + 1);
+    }
+    (*next)[IDX].push_back(&observer);
+    retire(snapshot_.exchange(next));
+  }
+
+  template <size_t IDX, typename T>
+  void unobserve(observer_t<T>& observer) {
+    std::lock_guard<std::mutex> lock{write_mutex_};
+    auto* next = new snapshot_t{*snapshot_.load()};
+    if (IDX < next->size()) {
+      auto& bucket = (*next)[IDX];
+      bucket.erase(std::remove(bucket.begin(), bucket.end(), &observer), bucket.end());
+    }
+    retire(snapshot_.exchange(next));
+  }
+
+ private:
+  using snapshot_t = std::vector<std::vector<void*>>;
+
+  struct alignas(64) reader_counter {
+    std::atomic<size_t> count{0};
+  };
+
+  class read_guard {
+   public:
+    explicit read_guard(concurrent_observer_registry& registry)
+        : counter_(registry.readers_[registry.epoch_.load() & 1].count) {
+      counter_.fetch_add(1);
+    }
+    ~read_guard() { counter_.fetch_sub(1); }
+
+   private:
+    std::atomic<size_t>& counter_;
+  };
+
+  // Readers may still use the previous version, it is reclaimed after a grace period
+  void retire(snapshot_t* previous) {
+    synchronize();
+    delete previous;
+  }
+
+  // Waits until every reader which started before the call finishes.
+  // Readers register on the counter of the current epoch, flipping the epoch
+  // twice (and waiting for the counter of the previous epoch each time) ensures
+  // that readers preempted between reading the epoch and registering are also covered.
+  void synchronize() {
+    for (int i = 0; i < 2; ++i) {
+      const size_t e = epoch_.fetch_add(1);
+      while (readers_[e & 1].count.load() != 0) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  std::atomic<snapshot_t*> snapshot_;
+  std::atomic<size_t> epoch_{0};
+  reader_counter readers_[2];
+
+  std::mutex write_mutex_;
+};
+
+}  // namespace tsar::observable
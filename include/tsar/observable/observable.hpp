@@ -62,7 +62,7 @@ class observable_immutable {
   auto& container() { return CTX::container(this); }
   auto& observer_registry() { return container().get(observer_registry_marker{}); }
 
-  void fire() { observer_registry().template fire<observable_offset()>(*this); }
+  void fire() { observer_registry().template fire<observable_offset()>(data_); }
 };
 
 // A primitive-like (immutable) string implementation
@@ -2,8 +2,8 @@
 #pragma once
 
 #include "tsar/context_aware_tuple.hpp"
-#include "tsar/detail/packed_ptr.hpp"
 
+#include <algorithm>
 #include <type_traits>
 #include <vector>
 
@@ -114,24 +114,78 @@ class observer_forwarder {
   auto& outside_container() { return CTX::tuple_t::ctx_t::container(&inside_container()); }
 };
 
+// Observers are stored in buckets by the index of the observed item,
+// fire only iterates over the observers of the changed item
 template <typename CTX>
 class observer_registry {
  public:
+  // Notifications are delayed while a batch is alive, see begin_batch()
+  class batch {
+   public:
+    explicit batch(observer_registry& registry) : registry_(registry) { registry_.batch_depth_++; }
+
+    // Best effort: exceptions thrown by the observers are swallowed, call commit() to see them
+    ~batch() {
+      try {
+        commit();
+      } catch (...) {
+      }
+    }
+
+    // Ends the batch, and sends the notifications if it's the outermost one.
+    // If an observer throws, the exception propagates, and the remaining notifications are dropped.
+    void commit() {
+      if (committed_) {
+        return;
+      }
+      committed_ = true;
+      if (--registry_.batch_depth_ == 0) {
+        registry_.flush();
+      }
+    }
+
+    batch(batch const&) = delete;
+    batch(batch&&) = delete;
+    batch& operator=(batch const&) = delete;
+    batch& operator=(batch&&) = delete;
+
+   private:
+    observer_registry& registry_;
+    bool committed_ = false;
+  };
+
   ~observer_registry() {}
 
+  // Starts a batch: until the returned object is committed or goes out of scope, changes are only recorded,
+  // then every changed item fires exactly once, with its final value.
+  // Batches can be nested, notifications are sent when the outermost batch ends.
+  [[nodiscard]] batch begin_batch() { return batch{*this}; }
+
   template <size_t IDX, typename T>
   void fire(T& item_ref) {
-    for (auto const& item : observers_) {
-      if (item.data() == IDX) {
-        observer_of_nth_type<IDX, T>(item.ptr())->on_changed(item_ref);
+    if (batch_depth_ > 0) {
+      if (IDX >= dirty_.size()) {
+        dirty_.resize(IDX + 1);
       }
+      if (!dirty_[IDX]) {
+        dirty_[IDX] = true;
+        pending_.push_back({IDX, &item_ref, &fire_pending<IDX, T>});
+      }
+      return;
+    }
+
+    if (IDX >= buckets_.size()) {
+      return;
+    }
+    for (void* observer : buckets_[IDX]) {
+      observer_of_nth_type<IDX, T>(observer)->on_changed(item_ref);
     }
   }
 
   template <size_t DUMMY>
   constexpr static size_t observable_increment() {
-    // TODO: 0?
-    return 1;
+    // the registry itself can't be observed, it doesn't need a slot
+    return 0;
   }
 
   constexpr static size_t observable_offset() {
@@ -141,14 +195,20 @@ class observer_registry {
   template <size_t IDX, typename T>
   void observe(observer_t<T>& observer) {
     // TODO: static assert
-    observers_.push_back(detail::packed_ptr{&observer, IDX});
+    if (IDX >= buckets_.size()) {
+      buckets_.resize(IDX + 1);
+    }
+    buckets_[IDX].push_back(&observer);
   }
 
   template <size_t IDX, typename T>
   void unobserve(observer_t<T>& observer) {
     // TODO: static assert
-    observers_.erase(std::remove(observers_.begin(), observers_.end(), detail::packed_ptr{&observer, IDX}),
-                     observers_.end());
+    if (IDX >= buckets_.size()) {
+      return;
+    }
+    auto& bucket = buckets_[IDX];
+    bucket.erase(std::remove(bucket.begin(), bucket.end(), &observer), bucket.end());
   }
 
  private:
@@ -158,7 +218,34 @@ class observer_registry {
     return static_cast<t*>(ptr);
   }
 
-  std::vector<detail::packed_ptr> observers_;
+  struct pending_fire {
+    size_t idx;
+    void* item;
+    void (*fire)(observer_registry&, void*);
+  };
+
+  template <size_t IDX, typename T>
+  static void fire_pending(observer_registry& registry, void* item) {
+    registry.template fire<IDX>(*static_cast<T*>(item));
+  }
+
+  void flush() {
+    // observers are allowed to start new batches, or change other items
+    auto pending = std::move(pending_);
+    pending_.clear();
+    for (auto const& p : pending) {
+      dirty_[p.idx] = false;
+    }
+    for (auto const& p : pending) {
+      p.fire(*this, p.item);
+    }
+  }
+
+  std::vector<std::vector<void*>> buckets_;
+
+  size_t batch_depth_ = 0;
+  std::vector<bool> dirty_;
+  std::vector<pending_fire> pending_;
 
   auto& container() { return CTX::container(this); }
 };
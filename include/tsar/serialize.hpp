@@ -0,0 +1,202 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "tsar/compiler_support.hpp"
+#include "tsar/field.hpp"
+
+// Binary serialization of TSAR_STRUCTs
+//
+// The encoding is driven by the struct metadata:
+// * adjacent trivially copyable fields are merged into a single range at compile time,
+//   which is copied with one memcpy
+// * other fields (and cold fields) are encoded one by one with tsar::serializer<T>
+//
+// Trivially copyable data is stored in the host byte order, the format is meant for
+// exchanging data between processes of the same binary, not as a portable archive format.
+
+namespace tsar {
+
+// Customization point for field types which aren't trivially copyable
+//
+// Specializations have to provide:
+// static void write(std::vector<std::byte>& out, T const& value);
+// static std::size_t read(std::span<const std::byte> in, T& value); // returns the number of bytes consumed
+//
+// The primary template copies the object representation, it's used for trivially copyable fields
+// which can't be merged with their neighbours (e.g. cold fields)
+template <typename T>
+struct serializer {
+  static_assert(std::is_trivially_copyable_v<T>, "tsar::serializer has to be specialized for this type");
+
+  static void write(std::vector<std::byte>& out, T const& value);
+  static std::size_t read(std::span<const std::byte> in, T& value);
+};
+
+template <typename S>
+void serialize(S const& obj, std::vector<std::byte>& out);
+
+// Returns the number of bytes consumed, throws std::out_of_range if the buffer is too short
+template <typename S>
+std::size_t deserialize(S& obj, std::span<const std::byte> in);
+
+namespace serialize_detail {
+
+template <typename S, std::size_t IDX>
+using meta_at_t = decltype(S::meta().template member_at<IDX>());
+
+struct segment {
+  std::size_t field;  // first field in the segment
+  std::size_t offset;
+  std::size_t size;
+  std::size_t align;
+  bool trivial;
+};
+
+template <std::size_t N>
+struct plan {
+  std::array<segment, N> segments{};
+  std::size_t count = 0;
+};
+
+template <typename S, std::size_t... Is>
+TSAR_CONSTEVAL auto make_plan(std::index_sequence<Is...>) {
+  const segment fields[] = {segment{Is, S::meta().template member_at<Is>().offset(),
+                                    sizeof(typename meta_at_t<S, Is>::value_t),
+                                    alignof(typename meta_at_t<S, Is>::value_t),
+                                    std::is_trivially_copyable_v<typename meta_at_t<S, Is>::value_t> &&
+                                        !meta_at_t<S, Is>::cold}...};
+
+  plan<sizeof...(Is)> ret;
+  for (auto const& f : fields) {
+    // only merge fields without a gap between them: the metadata can't tell padding apart from plain members
+    // (or the cold block) declared between the fields, which even fit into gaps smaller than the alignment
+    if (ret.count > 0 && ret.segments[ret.count - 1].trivial && f.trivial &&
+        f.offset == ret.segments[ret.count - 1].offset + ret.segments[ret.count - 1].size) {
+      auto& last = ret.segments[ret.count - 1];
+      last.size = f.offset + f.size - last.offset;
+    } else {
+      ret.segments[ret.count++] = f;
+    }
+  }
+  return ret;
+}
+
+template <typename S>
+inline constexpr auto plan_for = make_plan<S>(std::make_index_sequence<S::meta().size()>());
+
+inline void check_size(std::span<const std::byte> in, std::size_t size) {
+  if (in.size() < size) {
+    throw std::out_of_range("tsar::deserialize: buffer too short");
+  }
+}
+
+template <typename S, std::size_t SEG>
+void write_segment(S const& obj, std::vector<std::byte>& out) {
+  constexpr segment seg = plan_for<S>.segments[SEG];
+  if constexpr (seg.trivial) {
+    auto const& base = static_cast<typename S::struct_t const&>(obj);
+    const std::size_t pos = out.size();
+    out.resize(pos + seg.size);
+    std::memcpy(out.data() + pos, reinterpret_cast<const std::byte*>(&base) + seg.offset, seg.size);
+  } else {
+    using meta_t = meta_at_t<S, seg.field>;
+    serializer<typename meta_t::value_t>::write(out, meta_t::access(obj));
+  }
+}
+
+template <typename S, std::size_t SEG>
+std::size_t read_segment(S& obj, std::span<const std::byte> in) {
+  constexpr segment seg = plan_for<S>.segments[SEG];
+  if constexpr (seg.trivial) {
+    check_size(in, seg.size);
+    auto& base = static_cast<typename S::struct_t&>(obj);
+    std::memcpy(reinterpret_cast<std::byte*>(&base) + seg.offset, in.data(), seg.size);
+    return seg.size;
+  } else {
+    using meta_t = meta_at_t<S, seg.field>;
+    return serializer<typename meta_t::value_t>::read(in, meta_t::access(obj));
+  }
+}
+
+template <typename S, std::size_t... SEGs>
+void serialize_impl(S const& obj, std::vector<std::byte>& out, std::index_sequence<SEGs...>) {
+  (write_segment<S, SEGs>(obj, out), ...);
+}
+
+template <typename S, std::size_t... SEGs>
+std::size_t deserialize_impl(S& obj, std::span<const std::byte> in, std::index_sequence<SEGs...>) {
+  std::size_t consumed = 0;
+  ((consumed += read_segment<S, SEGs>(obj, in.subspan(consumed))), ...);
+  return consumed;
+}
+
+}  // namespace serialize_detail
+
+template <typename CHAR_T, typename TRAITS_T, typename ALLOC_T>
+struct serializer<std::basic_string<CHAR_T, TRAITS_T, ALLOC_T>> {
+  static_assert(std::is_trivially_copyable_v<CHAR_T>);
+
+  using string_t = std::basic_string<CHAR_T, TRAITS_T, ALLOC_T>;
+
+  static void write(std::vector<std::byte>& out, string_t const& value) {
+    const std::uint64_t length = value.size();
+    const std::size_t pos = out.size();
+    out.resize(pos + sizeof(length) + length * sizeof(CHAR_T));
+    std::memcpy(out.data() + pos, &length, sizeof(length));
+    std::memcpy(out.data() + pos + sizeof(length), value.data(), length * sizeof(CHAR_T));
+  }
+
+  static std::size_t read(std::span<const std::byte> in, string_t& value) {
+    std::uint64_t length = 0;
+    serialize_detail::check_size(in, sizeof(length));
+    std::memcpy(&length, in.data(), sizeof(length));
+    serialize_detail::check_size(in.subspan(sizeof(length)), length * sizeof(CHAR_T));
+    value.resize(length);
+    std::memcpy(value.data(), in.data() + sizeof(length), length * sizeof(CHAR_T));
+    return sizeof(length) + length * sizeof(CHAR_T);
+  }
+};
+
+template <typename T>
+void serializer<T>::write(std::vector<std::byte>& out, T const& value) {
+  const std::size_t pos = out.size();
+  out.resize(pos + sizeof(T));
+  std::memcpy(out.data() + pos, &value, sizeof(T));
+}
+
+template <typename T>
+std::size_t serializer<T>::read(std::span<const std::byte> in, T& value) {
+  serialize_detail::check_size(in, sizeof(T));
+  std::memcpy(&value, in.data(), sizeof(T));
+  return sizeof(T);
+}
+
+// Nested TSAR_STRUCTs are serialized recursively
+template <typename T>
+requires requires { T::meta(); }
+struct serializer<T> {
+  static void write(std::vector<std::byte>& out, T const& value) { serialize(value, out); }
+  static std::size_t read(std::span<const std::byte> in, T& value) { return deserialize(value, in); }
+};
+
+template <typename S>
+void serialize(S const& obj, std::vector<std::byte>& out) {
+  serialize_detail::serialize_impl(obj, out, std::make_index_sequence<serialize_detail::plan_for<S>.count>());
+}
+
+template <typename S>
+std::size_t deserialize(S& obj, std::span<const std::byte> in) {
+  return serialize_detail::deserialize_impl(obj, in, std::make_index_sequence<serialize_detail::plan_for<S>.count>());
+}
+
+}  // namespace tsar
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "tsar/detail/named_row.hpp"
+#include "tsar/field.hpp"
+
+// Structure of arrays container for TSAR_STRUCTs
+//
+// soa_vector<foo> stores every field of foo in its own std::vector, so scans
+// touching only a few fields only load the columns they need.
+//
+// Elements are accessed through row proxies, which have the same member
+// names as the original struct, but hold references into the columns:
+//
+//   tsar::soa_vector<foo> v;
+//   v.push_back(f);
+//   v[0].a = 42;
+//   for (auto& a : v.column<0>()) { ... }
+
+namespace tsar {
+
+namespace soa_detail {
+
+template <typename S, std::size_t IDX>
+using meta_at_t = decltype(S::meta().template member_at<IDX>());
+
+template <typename S, std::size_t IDX>
+using value_at_t = typename meta_at_t<S, IDX>::value_t;
+
+template <typename SOA_T, typename ROW_T>
+class row_iterator {
+ public:
+  using difference_type = std::ptrdiff_t;
+  using value_type = ROW_T;
+
+  row_iterator() = default;
+  row_iterator(SOA_T* soa, std::size_t idx) : soa_(soa), idx_(idx) {}
+
+  ROW_T operator*() const { return (*soa_)[idx_]; }
+  detail::arrow_proxy<ROW_T> operator->() const { return {(*soa_)[idx_]}; }
+
+  row_iterator& operator++() {
+    ++idx_;
+    return *this;
+  }
+
+  row_iterator operator++(int) {
+    auto ret = *this;
+    ++idx_;
+    return ret;
+  }
+
+  bool operator==(row_iterator const& o) const { return idx_ == o.idx_; }
+  bool operator!=(row_iterator const& o) const { return idx_ != o.idx_; }
+
+ private:
+  SOA_T* soa_ = nullptr;
+  std::size_t idx_ = 0;
+};
+
+}  // namespace soa_detail
+
+template <typename S, typename I>
+class soa_vector_impl;
+
+template <typename S, std::size_t... Is>
+class soa_vector_impl<S, std::index_sequence<Is...>> {
+ public:
+  template <std::size_t IDX>
+  using column_t = std::vector<soa_detail::value_at_t<S, IDX>>;
+
+  using value_type = S;
+  using reference = detail::named_row<
+      typename soa_detail::meta_at_t<S, Is>::template named_member_t<typename column_t<Is>::reference>...>;
+  using const_reference = detail::named_row<
+      typename soa_detail::meta_at_t<S, Is>::template named_member_t<typename column_t<Is>::const_reference>...>;
+  using iterator = soa_detail::row_iterator<soa_vector_impl, reference>;
+  using const_iterator = soa_detail::row_iterator<const soa_vector_impl, const_reference>;
+
+  std::size_t size() const { return std::get<0>(columns_).size(); }
+  bool empty() const { return size() == 0; }
+
+  void reserve(std::size_t n) { (std::get<Is>(columns_).reserve(n), ...); }
+  void resize(std::size_t n) { (std::get<Is>(columns_).resize(n), ...); }
+  void clear() { (std::get<Is>(columns_).clear(), ...); }
+  void pop_back() { (std::get<Is>(columns_).pop_back(), ...); }
+
+  // Appends the fields of an existing struct instance
+  void push_back(S const& s) {
+    append_row([&](auto& column, auto idx) { column.push_back(soa_detail::meta_at_t<S, idx()>::access(s)); });
+  }
+
+  // Appends a new row, with one parameter per field
+  template <typename... ARGS>
+  void emplace_back(ARGS&&... args) {
+    static_assert(sizeof...(ARGS) == sizeof...(Is), "emplace_back requires one argument per field");
+    auto fields = std::forward_as_tuple(std::forward<ARGS>(args)...);
+    append_row([&](auto& column, auto idx) { column.emplace_back(std::get<idx()>(std::move(fields))); });
+  }
+
+  reference operator[](std::size_t idx) { return reference{{std::get<Is>(columns_)[idx]}...}; }
+  const_reference operator[](std::size_t idx) const { return const_reference{{std::get<Is>(columns_)[idx]}...}; }
+
+  template <std::size_t IDX>
+  column_t<IDX>& column() {
+    return std::get<IDX>(columns_);
+  }
+
+  template <std::size_t IDX>
+  column_t<IDX> const& column() const {
+    return std::get<IDX>(columns_);
+  }
+
+  iterator begin() { return {this, 0}; }
+  iterator end() { return {this, size()}; }
+  const_iterator begin() const { return {this, 0}; }
+  const_iterator end() const { return {this, size()}; }
+
+ private:
+  // Calls APPEND for every column, and removes the already appended elements if one of them throws,
+  // so the columns always have the same length
+  template <typename APPEND_T>
+  void append_row(APPEND_T&& append) {
+    std::size_t appended = 0;
+    try {
+      (..., (append(std::get<Is>(columns_), std::integral_constant<std::size_t, Is>{}), ++appended));
+    } catch (...) {
+      (..., (Is < appended ? std::get<Is>(columns_).pop_back() : void()));
+      throw;
+    }
+  }
+
+  std::tuple<column_t<Is>...> columns_;
+};
+
+template <typename S>
+class soa_vector : public soa_vector_impl<S, std::make_index_sequence<S::meta().size()>> {
+  static_assert(S::meta().size() > 0, "soa_vector requires at least one field");
+};
+
+}  // namespace tsar
@@ -1,59 +1,196 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstring>
 #include <tuple>
 #include <type_traits>
+#include <utility>
+#include "tsar/detail/hash.hpp"
 #include "tsar/typesort.hpp"
 
 namespace tsar {
 
-enum class ordering { original, optimal };
+// original: declaration order
+// optimal: descending alignment, see descending_type_orderings
+// bitpacked: like optimal, but bools are also packed into shared words, like members tagged with bitfield<E, BITS>
+// packed: declaration order without any padding, members are accessed with unaligned loads / stores
+enum class ordering { original, optimal, bitpacked, packed };
 
 template <ordering O, typename... T>
 struct standard_storage_ordering;
 
 template <typename... T>
 struct standard_storage_ordering<ordering::optimal, T...> {
-  static constexpr auto ordering = descending_type_order<T...>();
+  static constexpr auto ordering = descending_type_orderings<T...>();
 };
 
 template <typename... T>
 struct standard_storage_ordering<ordering::original, T...> {
-  static constexpr auto ordering = original_type_order<T...>();
+  static constexpr auto ordering = original_type_orderings<T...>();
 };
 
+template <typename T>
+struct bitpacked_member {
+  using type = T;
+};
+
+template <>
+struct bitpacked_member<bool> {
+  using type = bitfield<bool, 1>;
+};
+
+template <typename... T>
+struct standard_storage_ordering<ordering::bitpacked, T...> {
+  static constexpr auto ordering = descending_type_orderings<typename bitpacked_member<T>::type...>();
+};
+
+template <typename... T>
+struct standard_storage_ordering<ordering::packed, T...> {
+  static constexpr auto ordering = original_type_orderings<unaligned<T>...>();
+};
+
+// Proxy reference to an unaligned member, returned by standard_storage::get for packed members
+template <typename T>
+class unaligned_reference {
+ public:
+  explicit unaligned_reference(char* data) : data_(data) {}
+
+  operator T() const {
+    T ret;
+    std::memcpy(&ret, data_, sizeof(T));
+    return ret;
+  }
+
+  unaligned_reference& operator=(T const& value) {
+    std::memcpy(data_, &value, sizeof(T));
+    return *this;
+  }
+
+  unaligned_reference& operator=(unaligned_reference const& o) { return *this = static_cast<T>(o); }
+
+ private:
+  char* data_;
+};
+
+// Proxy reference to a bitfield member, returned by standard_storage::get for bitpacked members
+template <typename T, typename WORD_T, std::size_t SHIFT, std::size_t BITS>
+class bit_reference {
+ public:
+  explicit bit_reference(WORD_T& word) : word_(word) {}
+
+  operator T() const { return static_cast<T>((word_ >> SHIFT) & mask); }
+
+  bit_reference& operator=(T value) {
+    word_ = static_cast<WORD_T>((word_ & ~(mask << SHIFT)) | ((static_cast<WORD_T>(value) & mask) << SHIFT));
+    return *this;
+  }
+
+  bit_reference& operator=(bit_reference const& o) { return *this = static_cast<T>(o); }
+
+ private:
+  static constexpr WORD_T mask = static_cast<WORD_T>(BITS == 8 * sizeof(WORD_T) ? ~WORD_T{0} : (WORD_T{1} << BITS) - 1);
+
+  WORD_T& word_;
+};
+
+template <typename WORD_T, std::size_t N>
+struct bit_words {
+  WORD_T words[N] = {};
+};
+
+template <typename WORD_T>
+struct bit_words<WORD_T, 0> {};
+
+// Stores the members T... in a single buffer, ordered by O
+//
+// Empty members take a single byte each, after the other members: they never overlap a member,
+// and repeated empty types get distinct addresses.
+//
+// Members can be tagged with cache_group<G, T>, to place them on their own cache line(s), see typesort.hpp:
+//   standard_storage<ordering::optimal, cache_group<0, std::atomic<int>>, cache_group<1, std::atomic<int>>>
+//
+// Bitpacked and unaligned members can't be accessed by reference, get<IDX>() returns a bit_reference or
+// unaligned_reference proxy for them (and a value for const access). is_proxied<IDX>() tells them apart.
 template <ordering O, typename... T>
 class standard_storage : private standard_storage_ordering<O, T...> {
  private:
   static constexpr auto ordering = standard_storage_ordering<O, T...>::ordering;
 
  public:
+  // The stored type, without the cache_group tag
+  template <std::size_t IDX>
+  using nth_type = member_t<std::tuple_element_t<IDX, std::tuple<T...>>>;
+
+  template <std::size_t IDX>
+  static constexpr bool is_bitpacked() {
+    return bit_slots[IDX].bits != 0;
+  }
+
   template <std::size_t IDX>
-  using nth_type = typename std::remove_reference_t<decltype(std::get<IDX>(ordering))>::type;
+  static constexpr bool is_unaligned() {
+    return unaligned_members[IDX];
+  }
+
+  template <std::size_t IDX>
+  static constexpr bool is_proxied() {
+    return is_bitpacked<IDX>() || is_unaligned<IDX>();
+  }
 
   template <std::size_t IDX>
-  auto& get() {
-    return reinterpret_cast<nth_type<IDX>&>(data_[nth_offset(IDX)]);
+  decltype(auto) get() {
+    if constexpr (is_bitpacked<IDX>()) {
+      constexpr bit_slot slot = bit_slots[IDX];
+      return bit_reference<nth_type<IDX>, word_t, slot.shift, slot.bits>{bits_.words[slot.word]};
+    } else if constexpr (is_unaligned<IDX>()) {
+      return unaligned_reference<nth_type<IDX>>{&data_[nth_offset(IDX)]};
+    } else {
+      return reinterpret_cast<nth_type<IDX>&>(data_[nth_offset(IDX)]);
+    }
   }
 
   template <std::size_t IDX>
-  auto const& get() const {
-    return reinterpret_cast<nth_type<IDX> const&>(data_[nth_offset(IDX)]);
+  decltype(auto) get() const {
+    if constexpr (is_proxied<IDX>()) {
+      return static_cast<nth_type<IDX>>(const_cast<standard_storage&>(*this).template get<IDX>());
+    } else {
+      return reinterpret_cast<nth_type<IDX> const&>(data_[nth_offset(IDX)]);
+    }
   }
 
   template <std::size_t IDX>
-  auto&& rvalue() {
-    return reinterpret_cast<nth_type<IDX>&&>(data_[nth_offset(IDX)]);
+  decltype(auto) rvalue() {
+    if constexpr (is_proxied<IDX>()) {
+      return std::as_const(*this).template get<IDX>();
+    } else {
+      return reinterpret_cast<nth_type<IDX>&&>(data_[nth_offset(IDX)]);
+    }
   }
 
   template <std::size_t IDX>
   void* addr() {
+    static_assert(!is_bitpacked<IDX>(), "Bitpacked members don't have an address");
+    // unaligned members have an address, but it can't be used as a T*
     return static_cast<void*>(&data_[nth_offset(IDX)]);
   }
 
   constexpr static std::size_t size() { return sizeof...(T); }
 
-  constexpr static std::size_t size_in_bytes() { return layout[size() - 1].offset + layout[size() - 1].size; }
+  constexpr static std::size_t size_in_bytes() { return calculate_layout_stats(layout).size; }
+
+  // Bytes between the members, which aren't used by any of them
+  constexpr static std::size_t padding_in_bytes() { return calculate_layout_stats(layout).padding; }
+
+  // True if equal values always have equal bytes: the members are integers, enums or pointers without padding
+  // between them, so they can be compared and hashed as a single block (see bytes())
+  constexpr static bool bytewise_comparable() {
+    return calculate_layout_stats(layout).padding == 0 && calculate_total_bits(bits) == 0 &&
+           (... && detail::bytewise_comparable_v<T>);
+  }
+
+  // The first size_in_bytes() bytes contain every member, except for bitpacked ones
+  const char* bytes() const { return data_; }
 
   constexpr static std::size_t offset_for(std::size_t idx) {
     return offsetof(standard_storage, data_) + nth_offset(idx);
@@ -65,9 +202,25 @@ class standard_storage : private standard_storage_ordering<O, T...> {
 
   constexpr static std::size_t nth_offset(std::size_t idx) { return layout[indexing[idx]].offset; }
 
-  static constexpr size_t maxalign() { return alignof(std::tuple<T...>); }
+  static constexpr auto unaligned_members = calculate_unaligned(ordering);
+  static constexpr auto bits = calculate_bits(ordering);
+  using word_t = bit_word_t<calculate_total_bits(bits)>;
+  static constexpr auto bit_slots = calculate_bit_slots<8 * sizeof(word_t)>(bits);
+
+  // Cache groups also require the storage to start on a cache line
+  static constexpr size_t maxalign() { return calculate_layout_stats(layout).align; }
 
-  alignas(maxalign()) char data_[size_in_bytes()];
+  // Only bitfield members would leave the data empty
+  alignas(maxalign()) char data_[size_in_bytes() > 0 ? size_in_bytes() : 1];
+  [[no_unique_address]] bit_words<word_t, calculate_bit_word_count(bit_slots)> bits_;
+};
+
+// Compile time report about the size of the different orderings
+template <typename... T>
+struct layout_report {
+  static constexpr std::size_t original_size = sizeof(standard_storage<ordering::original, T...>);
+  static constexpr std::size_t optimal_size = sizeof(standard_storage<ordering::optimal, T...>);
+  static constexpr std::size_t bytes_saved = original_size - optimal_size;
 };
 
 }  // namespace tsar
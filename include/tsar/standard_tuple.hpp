@@ -1,6 +1,15 @@
+#pragma once
 
+
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <tuple>
+#include <type_traits>
 
+#include "tsar/detail/hash.hpp"
 #include "tsar/standard_storage.hpp"
 #include "tsar/typewrap.hpp"
 
@@ -62,6 +71,10 @@ class standard_tuple_impl<O, MAPPING_T, LIFECYCLE_T, std::index_sequence<Is...>,
   using storage_t = standard_storage<O, T...>;
   storage_t data_;
 
+  static constexpr bool trivially_copyable =
+      std::is_same_v<LIFECYCLE_T<void>, standard_tuple_lifecycle_proxy<void>> &&
+      (... && std::is_trivially_copyable_v<member_t<T>>);
+
   template <typename... Ts>
   void swallow(Ts&&...) {}
 
@@ -72,71 +85,146 @@ class standard_tuple_impl<O, MAPPING_T, LIFECYCLE_T, std::index_sequence<Is...>,
   }
 
   template <size_t IDX>
-  auto&& move_out() {
+  decltype(auto) move_out() {
     static_assert(IDX < size(), "Overindexing a standard tuple");
     return data_.template rvalue<IDX>();
   }
 
+  // Bitpacked and unaligned members can't be accessed by reference, they are assigned through their proxies
+
+  template <size_t IDX, typename... TA>
+  int construct_member(TA&&... args) {
+    if constexpr (storage_t::template is_proxied<IDX>()) {
+      data_.template get<IDX>() = nth_type<IDX>(std::forward<TA>(args)...);
+      return 0;
+    } else {
+      return LIFECYCLE_T<nth_type<IDX>>::construct(addr<IDX>(), std::forward<TA>(args)...);
+    }
+  }
+
+  template <size_t IDX, typename TA>
+  int assign_member(TA&& value) {
+    if constexpr (storage_t::template is_proxied<IDX>()) {
+      data_.template get<IDX>() = nth_type<IDX>(std::forward<TA>(value));
+      return 0;
+    } else {
+      return LIFECYCLE_T<nth_type<IDX>>::assign(get<IDX>(), std::forward<TA>(value));
+    }
+  }
+
+  template <size_t IDX>
+  int destruct_member() {
+    if constexpr (storage_t::template is_proxied<IDX>()) {
+      return 0;
+    } else {
+      return LIFECYCLE_T<nth_type<IDX>>::destruct(&get<IDX>());
+    }
+  }
+
  public:
-  standard_tuple_impl() noexcept { swallow(LIFECYCLE_T<T>::construct(addr<Is>())...); }
+  standard_tuple_impl() noexcept { swallow(construct_member<Is>()...); }
 
   template <typename... TT>
   standard_tuple_impl(TT&&... args) noexcept {
-    swallow(LIFECYCLE_T<T>::construct(addr<Is>(), std::forward<TT>(args))...);
+    swallow(construct_member<Is>(std::forward<TT>(args))...);
   }
 
   template <typename... TT>
   standard_tuple_impl(TT const&... args) noexcept {
-    swallow(LIFECYCLE_T<T>::construct(addr<Is>(), args)...);
+    swallow(construct_member<Is>(args)...);
   }
 
-  standard_tuple_impl(T&&... args) noexcept {
-    swallow(LIFECYCLE_T<T>::construct(addr<Is>(), std::forward<T>(args))...);
+  standard_tuple_impl(member_t<T>&&... args) noexcept {
+    swallow(construct_member<Is>(std::forward<member_t<T>>(args))...);
   }
 
-  standard_tuple_impl(T const&... args) noexcept { swallow(LIFECYCLE_T<T>::construct(addr<Is>(), args)...); }
+  standard_tuple_impl(member_t<T> const&... args) noexcept { swallow(construct_member<Is>(args)...); }
 
-  standard_tuple_impl(standard_tuple_impl const& o) noexcept {
-    swallow(LIFECYCLE_T<T>::construct(addr<Is>(), o.get<Is>())...);
-  }
+  // Trivially copyable members with the default lifecycle are copied as a single block,
+  // and the tuple itself is trivially copyable
 
-  standard_tuple_impl(standard_tuple_impl&& o) noexcept {
-    swallow(LIFECYCLE_T<T>::construct(addr<Is>(), o.move_out<Is>())...);
-  }
+  standard_tuple_impl(standard_tuple_impl const& o) noexcept requires trivially_copyable = default;
+  standard_tuple_impl(standard_tuple_impl&& o) noexcept requires trivially_copyable = default;
+  ~standard_tuple_impl() noexcept requires trivially_copyable = default;
+  standard_tuple_impl& operator=(standard_tuple_impl const& o) noexcept requires trivially_copyable = default;
+  standard_tuple_impl& operator=(standard_tuple_impl&& o) noexcept requires trivially_copyable = default;
 
-  ~standard_tuple_impl() noexcept { swallow(LIFECYCLE_T<T>::destruct(&get<Is>())...); }
+  standard_tuple_impl(standard_tuple_impl const& o) noexcept { swallow(construct_member<Is>(o.get<Is>())...); }
+
+  standard_tuple_impl(standard_tuple_impl&& o) noexcept { swallow(construct_member<Is>(o.move_out<Is>())...); }
+
+  ~standard_tuple_impl() noexcept { swallow(destruct_member<Is>()...); }
 
   standard_tuple_impl& operator=(standard_tuple_impl const& o) noexcept {
-    swallow(LIFECYCLE_T<T>::assign(get<Is>(), o.get<Is>())...);
+    swallow(assign_member<Is>(o.get<Is>())...);
     return *this;
   }
 
   standard_tuple_impl& operator=(standard_tuple_impl&& o) noexcept {
-    swallow(LIFECYCLE_T<T>::assign(get<Is>(), o.move_out<Is>())...);
+    swallow(assign_member<Is>(o.move_out<Is>())...);
     return *this;
   }
 
-  bool operator==(standard_tuple_impl const& o) const { return (... && (get<Is>() == o.get<Is>())); }
-  bool operator!=(standard_tuple_impl const& o) const { return (... || (get<Is>() != o.get<Is>())); }
+  // Comparison and hashing work on the raw data block when possible (see standard_storage::bytewise_comparable),
+  // scalar members are compared without short circuiting, other members one by one
+
+  bool operator==(standard_tuple_impl const& o) const {
+    if constexpr (storage_t::bytewise_comparable()) {
+      return std::memcmp(data_.bytes(), o.data_.bytes(), storage_t::size_in_bytes()) == 0;
+    } else if constexpr ((... && std::is_scalar_v<member_t<T>>)) {
+      return (... & (get<Is>() == o.get<Is>()));
+    } else {
+      return (... && (get<Is>() == o.get<Is>()));
+    }
+  }
+
+  // The negation of ==, so both take the same path, only members without == are compared with !=
+  bool operator!=(standard_tuple_impl const& o) const {
+    if constexpr ((... && std::equality_comparable<member_t<T>>)) {
+      return !(*this == o);
+    } else {
+      return (... || (get<Is>() != o.get<Is>()));
+    }
+  }
+
+  // Lexicographic, in declaration order
+  auto operator<=>(standard_tuple_impl const& o) const requires(... && std::three_way_comparable<member_t<T>>) {
+    std::common_comparison_category_t<std::compare_three_way_result_t<member_t<T>>...> ret =
+        std::strong_ordering::equal;
+    static_cast<void>((... || ((ret = get<Is>() <=> o.get<Is>()) != 0)));
+    return ret;
+  }
+
+  std::size_t hash() const {
+    if constexpr (storage_t::bytewise_comparable()) {
+      return detail::hash_bytes(data_.bytes(), storage_t::size_in_bytes());
+    } else {
+      std::uint64_t ret = 0;
+      ((ret = detail::hash_combine(ret, std::hash<member_t<T>>{}(get<Is>()))), ...);
+      return ret;
+    }
+  }
+
+  // Bitpacked and unaligned members are returned as proxies (or values, for const access)
 
   template <typename TT>
-  auto& get(TT const& /* unused */) {
+  decltype(auto) get(TT const& /* unused */) {
     return get<MAPPING_T::template index_for(TT{})>();
   }
 
   template <typename TT>
-  auto const& get(TT const& /* unused */) const {
+  decltype(auto) get(TT const& /* unused */) const {
     return get<MAPPING_T::template index_for(TT{})>();
   }
 
   template <size_t IDX>
-  auto& get() {
+  decltype(auto) get() {
     static_assert(IDX < size(), "Overindexing a standard tuple");
     return data_.template get<IDX>();
   }
 
   template <size_t IDX>
-  auto const& get() const {
+  decltype(auto) get() const {
     static_assert(IDX < size(), "Overindexing a standard tuple");
     return data_.template get<IDX>();
   }
@@ -149,15 +237,18 @@ class standard_tuple_impl<O, MAPPING_T, LIFECYCLE_T, std::index_sequence<Is...>,
   template <size_t IDX>
   constexpr static size_t offset() {
     static_assert(IDX < size(), "Overindexing a standard tuple");
+    static_assert(!storage_t::template is_bitpacked<IDX>(), "Bitpacked members don't have an offset");
     return offsetof(standard_tuple_impl, data_) + storage_t::offset_for(IDX);
   }
 
   constexpr static size_t size() { return sizeof...(T); }
 
+  constexpr static bool bytewise_comparable() { return storage_t::bytewise_comparable(); }
+
   using std_tuple_t = std::tuple<T...>;
 
   template <size_t IDX>
-  using nth_type = typename std::tuple_element<IDX, std_tuple_t>::type;
+  using nth_type = member_t<typename std::tuple_element<IDX, std_tuple_t>::type>;
 };
 
 template <ordering O, typename MAPPING_T, template <typename> typename LIFECYCLE_PROXY, typename... T>
@@ -174,6 +265,22 @@ class standard_tuple
                                T...>::generic_standard_tuple;
 };
 
+// Packs bools (and members tagged with bitfield<E, BITS>) into shared words
+template <typename... T>
+class bitpacked_standard_tuple
+    : public generic_standard_tuple<ordering::bitpacked, index_mapping, standard_tuple_lifecycle_proxy, T...> {
+  using generic_standard_tuple<ordering::bitpacked, index_mapping, standard_tuple_lifecycle_proxy,
+                               T...>::generic_standard_tuple;
+};
+
+// Stores the members without any padding, trivially copyable members only
+template <typename... T>
+class packed_standard_tuple
+    : public generic_standard_tuple<ordering::packed, index_mapping, standard_tuple_lifecycle_proxy, T...> {
+  using generic_standard_tuple<ordering::packed, index_mapping, standard_tuple_lifecycle_proxy,
+                               T...>::generic_standard_tuple;
+};
+
 template <typename... T>
 class sorted_standard_tuple
     : public generic_standard_tuple<ordering::optimal, index_mapping, standard_tuple_lifecycle_proxy, T...> {
@@ -182,3 +289,30 @@ class sorted_standard_tuple
 };
 
 }  // namespace tsar
+
+template <tsar::ordering O, typename MAPPING_T, template <typename> typename LIFECYCLE_PROXY, typename... T>
+struct std::hash<tsar::generic_standard_tuple<O, MAPPING_T, LIFECYCLE_PROXY, T...>> {
+  std::size_t operator()(tsar::generic_standard_tuple<O, MAPPING_T, LIFECYCLE_PROXY, T...> const& t) const {
+    return t.hash();
+  }
+};
+
+template <typename... T>
+struct std::hash<tsar::standard_tuple<T...>> {
+  std::size_t operator()(tsar::standard_tuple<T...> const& t) const { return t.hash(); }
+};
+
+template <typename... T>
+struct std::hash<tsar::sorted_standard_tuple<T...>> {
+  std::size_t operator()(tsar::sorted_standard_tuple<T...> const& t) const { return t.hash(); }
+};
+
+template <typename... T>
+struct std::hash<tsar::bitpacked_standard_tuple<T...>> {
+  std::size_t operator()(tsar::bitpacked_standard_tuple<T...> const& t) const { return t.hash(); }
+};
+
+template <typename... T>
+struct std::hash<tsar::packed_standard_tuple<T...>> {
+  std::size_t operator()(tsar::packed_standard_tuple<T...> const& t) const { return t.hash(); }
+};
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "tsar/detail/perfect_hash.hpp"
+#include "tsar/log_search.hpp"
+
+// Read only maps built at compile time
+//
+//   static constexpr auto colors = tsar::make_static_map<std::string_view, int>({{"red", 1}, {"green", 2}});
+//   static constexpr auto sizes = tsar::make_static_map<int, std::size_t>({{4, 32}, {1, 8}});
+//
+//   const int* c = colors.find("red");  // nullptr if missing
+//   std::size_t s = sizes.at(4);        // throws std::out_of_range if missing
+//
+// As constexpr variables, the maps are stored in read only data, without any initialization at startup.
+//
+// String keys are found with a perfect hash table (see detail/perfect_hash.hpp), and a single key comparison.
+// Other keys are sorted, and found with log_search_sorted, a branchless binary search.
+// Duplicate keys are compile time errors.
+
+namespace tsar {
+
+namespace static_map_detail {
+
+template <typename K>
+inline constexpr bool hashed_v = std::is_same_v<K, std::string_view>;
+
+template <typename K, std::size_t N>
+struct no_lookup {
+  constexpr explicit no_lookup(std::array<K, N> const& /* unused */) {}
+};
+
+template <std::size_t N>
+struct hash_lookup {
+  constexpr explicit hash_lookup(std::array<std::string_view, N> const& keys) : table(make_table(keys)) {}
+
+  static constexpr detail::perfect_hash<N> make_table(std::array<std::string_view, N> const& keys) {
+    std::array<std::uint64_t, N> hashes{};
+    for (std::size_t i = 0; i < N; ++i) {
+      hashes[i] = detail::hash_string(keys[i]);
+    }
+    return detail::make_perfect_hash(hashes);
+  }
+
+  detail::perfect_hash<N> table;
+};
+
+template <typename K, std::size_t N>
+using lookup_t = std::conditional_t<hashed_v<K>, hash_lookup<N>, no_lookup<K, N>>;
+
+}  // namespace static_map_detail
+
+template <typename K, typename V, std::size_t N>
+class static_map {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+
+  constexpr explicit static_map(std::array<std::pair<K, V>, N> entries) : static_map(sorted(entries), 0) {}
+
+  // Returns the value of the key, or nullptr
+  constexpr V const* find(K const& key) const {
+    if constexpr (N == 0) {
+      return nullptr;
+    } else {
+      // missing keys can point past the end, clamping is cheaper than another branch
+      const std::size_t idx = std::min(index_of(key), N - 1);
+      return keys_[idx] == key ? &values_[idx] : nullptr;
+    }
+  }
+
+  constexpr bool contains(K const& key) const { return find(key) != nullptr; }
+
+  constexpr V const& at(K const& key) const {
+    if (V const* value = find(key)) {
+      return *value;
+    }
+    throw std::out_of_range("static_map: missing key");
+  }
+
+  constexpr static std::size_t size() { return N; }
+
+  // Keys and values in storage order: sorted, or in declaration order for string keys
+  constexpr std::array<K, N> const& keys() const { return keys_; }
+  constexpr std::array<V, N> const& values() const { return values_; }
+
+ private:
+  constexpr static_map(std::array<std::pair<K, V>, N> const& sorted_entries, int /* unused */)
+      : keys_(keys_of(sorted_entries)), values_(values_of(sorted_entries)), lookup_(keys_) {}
+
+  constexpr std::size_t index_of(K const& key) const {
+    if constexpr (static_map_detail::hashed_v<K>) {
+      return lookup_.table.find(detail::hash_string(key));
+    } else {
+      return log_search_sorted(keys_, key);
+    }
+  }
+
+  // Hashed keys keep their order, the perfect hash table checks for duplicates
+  static constexpr std::array<std::pair<K, V>, N> sorted(std::array<std::pair<K, V>, N> entries) {
+    if constexpr (!static_map_detail::hashed_v<K>) {
+      std::sort(entries.begin(), entries.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+      for (std::size_t i = 1; i < N; ++i) {
+        if (!(entries[i - 1].first < entries[i].first)) {
+          throw std::logic_error("static_map: duplicate key");
+        }
+      }
+    }
+    return entries;
+  }
+
+  static constexpr std::array<K, N> keys_of(std::array<std::pair<K, V>, N> const& entries) {
+    std::array<K, N> ret{};
+    for (std::size_t i = 0; i < N; ++i) {
+      ret[i] = entries[i].first;
+    }
+    return ret;
+  }
+
+  static constexpr std::array<V, N> values_of(std::array<std::pair<K, V>, N> const& entries) {
+    std::array<V, N> ret{};
+    for (std::size_t i = 0; i < N; ++i) {
+      ret[i] = entries[i].second;
+    }
+    return ret;
+  }
+
+  std::array<K, N> keys_;
+  std::array<V, N> values_;
+  [[no_unique_address]] static_map_detail::lookup_t<K, N> lookup_;
+};
+
+template <typename K, typename V, std::size_t N>
+constexpr static_map<K, V, N> make_static_map(std::pair<K, V> const (&entries)[N]) {
+  return static_map<K, V, N>{std::to_array(entries)};
+}
+
+}  // namespace tsar
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "tsar/cts.hpp"
+#include "tsar/detail/perfect_hash.hpp"
+
+// Switch on strings, with the cases known at compile time
+//
+//   tsar::switch_on(command,
+//                   tsar::on<"start"_s>([&] { start(); }),
+//                   tsar::on<"stop"_s>([&] { stop(); }),
+//                   tsar::otherwise([&] { unknown(command); }));
+//
+// The case names are placed into a perfect hash table at compile time (see detail/perfect_hash.hpp), so a switch
+// hashes the value once, compares it with a single case name, and calls the case through a table of function
+// pointers. The cost doesn't depend on the number of cases.
+//
+// The result is the common type of the case results. Without otherwise, a value matching no case returns a
+// value initialized result. Duplicate case names are compile time errors.
+
+namespace tsar {
+
+template <cts NAME, typename F>
+struct switch_case {
+  static constexpr auto name = NAME;
+  F f;
+};
+
+template <typename F>
+struct switch_default {
+  F f;
+};
+
+template <cts NAME, typename F>
+constexpr switch_case<NAME, std::decay_t<F>> on(F&& f) {
+  return {std::forward<F>(f)};
+}
+
+template <typename F>
+constexpr switch_default<std::decay_t<F>> otherwise(F&& f) {
+  return {std::forward<F>(f)};
+}
+
+namespace switch_detail {
+
+template <typename T>
+inline constexpr bool is_default_v = false;
+
+template <typename F>
+inline constexpr bool is_default_v<switch_default<F>> = true;
+
+template <typename T>
+struct result {
+  using type = std::invoke_result_t<decltype(T::f)&>;
+};
+
+template <auto... NAMES>
+struct table {
+  static constexpr std::size_t size = sizeof...(NAMES);
+  static constexpr std::array<std::string_view, size> names = {NAMES.view()...};
+  static constexpr auto hashes = detail::make_perfect_hash<size>({NAMES.hash()...});
+
+  // Returns the index of the case named value, or size
+  static constexpr std::size_t find(std::string_view value) {
+    const std::size_t idx = hashes.find(detail::hash_string(value));
+    return idx < size && names[idx] == value ? idx : size;
+  }
+};
+
+template <typename R, typename ARGS_T, std::size_t... Is>
+struct dispatcher {
+  using table_t = table<std::tuple_element_t<Is, ARGS_T>::name...>;
+
+  template <std::size_t I>
+  static constexpr R call(ARGS_T& args) {
+    return std::get<I>(args).f();
+  }
+
+  static constexpr std::array<R (*)(ARGS_T&), sizeof...(Is)> cases = {&call<Is>...};
+
+  static constexpr R dispatch(std::string_view value, ARGS_T& args) {
+    const std::size_t idx = table_t::find(value);
+    if (idx < sizeof...(Is)) {
+      return cases[idx](args);
+    }
+    if constexpr (is_default_v<std::tuple_element_t<std::tuple_size_v<ARGS_T> - 1, ARGS_T>>) {
+      return std::get<std::tuple_size_v<ARGS_T> - 1>(args).f();
+    } else {
+      return R();
+    }
+  }
+};
+
+template <typename R, typename ARGS_T, std::size_t... Is>
+constexpr dispatcher<R, ARGS_T, Is...> make_dispatcher(std::index_sequence<Is...>);
+
+}  // namespace switch_detail
+
+template <typename... ARGS>
+constexpr decltype(auto) switch_on(std::string_view value, ARGS&&... args) {
+  using args_t = std::tuple<std::decay_t<ARGS>...>;
+  using result_t = std::common_type_t<typename switch_detail::result<std::decay_t<ARGS>>::type...>;
+  constexpr bool has_default = (... || switch_detail::is_default_v<std::decay_t<ARGS>>);
+  static_assert(!has_default || switch_detail::is_default_v<std::tuple_element_t<sizeof...(ARGS) - 1, args_t>>,
+                "otherwise has to be the last case");
+
+  using dispatcher_t = decltype(switch_detail::make_dispatcher<result_t, args_t>(
+      std::make_index_sequence<sizeof...(ARGS) - (has_default ? 1 : 0)>()));
+  args_t args_tuple{std::forward<ARGS>(args)...};
+  return dispatcher_t::dispatch(value, args_tuple);
+}
+
+}  // namespace tsar
@@ -1,11 +1,80 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace tsar {
 
+// The size of the destructive interference range, fields in different cache groups never share a cache line
+inline constexpr std::size_t cache_line_size = 64;
+
+// Tag for a member of the type T, which belongs to the cache group G
+//
+// Every group starts on its own cache line, and the members after the group start on a new cache line.
+// Members written by different threads should be placed in different groups, to avoid false sharing.
+template <std::size_t G, typename T>
+struct cache_group {};
+
+// Tag for a bool or enum member of the type T, which is stored in BITS bits of a shared word
+//
+// Only used by ordering::bitpacked, where bools are also packed automatically.
+// Enum values have to be non negative, and representable in BITS bits.
+template <typename T, std::size_t BITS>
+struct bitfield {};
+
+// Tag for a trivially copyable member of the type T, which is stored without alignment
+//
+// Used by ordering::packed for every member.
+template <typename T>
+struct unaligned {};
+
+template <typename T>
+struct member_traits {
+  using type = T;
+  static constexpr std::size_t group = 0;        // ungrouped
+  static constexpr std::size_t bits = 0;         // stored directly, not in a bitfield
+  static constexpr bool is_unaligned = false;
+};
+
+template <std::size_t G, typename T>
+struct member_traits<cache_group<G, T>> {
+  using type = T;
+  static constexpr std::size_t group = G + 1;
+  static constexpr std::size_t bits = 0;
+  static constexpr bool is_unaligned = false;
+};
+
+template <typename T, std::size_t BITS>
+struct member_traits<bitfield<T, BITS>> {
+  static_assert(std::is_same_v<T, bool> || std::is_enum_v<T>, "Only bools and enums can be stored in bitfields");
+  static_assert(BITS > 0 && BITS <= 8 * sizeof(T), "Invalid bitfield width");
+
+  using type = T;
+  static constexpr std::size_t group = 0;
+  static constexpr std::size_t bits = BITS;
+  static constexpr bool is_unaligned = false;
+};
+
+template <typename T>
+struct member_traits<unaligned<T>> {
+  static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be stored unaligned");
+
+  using type = T;
+  static constexpr std::size_t group = 0;
+  static constexpr std::size_t bits = 0;
+  static constexpr bool is_unaligned = true;
+};
+
+// The stored type of a (possibly tagged) member
+template <typename T>
+using member_t = typename member_traits<T>::type;
+
 template <typename T, std::size_t order_t>
 struct type_ordering {
   static const std::size_t order = order_t;
@@ -16,35 +85,66 @@ struct type_ordering {
 
 template <typename... Tall>
 constexpr std::size_t larger_or_earlier_types(std::size_t idx) {
-  const std::size_t sizes[] = {alignof(Tall)...};
+  const std::size_t groups[] = {member_traits<Tall>::group...};
+  const std::size_t sizes[] = {alignof(member_t<Tall>)...};
+  const std::size_t group = groups[idx];
   const std::size_t size = sizes[idx];
   std::size_t match = 0;
   for (std::size_t i = 0; i < sizeof...(Tall); ++i) {
-    if (sizes[i] > size || (sizes[i] == size && i < idx)) {
+    if (groups[i] < group || (groups[i] == group && (sizes[i] > size || (sizes[i] == size && i < idx)))) {
       match++;
     }
   }
   return match;
 }
 
+// The members of a storage in declaration order, tagged with their position in the layout
+//
+// A plain pack instead of a std::tuple: instantiating a std::tuple of every member (and make_tuple) is
+// quadratic, and dominated the compile time of large storages.
+template <typename... Tall>  // type_ordering<T>...
+struct type_orderings {};
+
+template <typename... Tall>  // type_ordering<T>...
+constexpr std::tuple<Tall...> as_tuple(type_orderings<Tall...>) {
+  return {};
+}
+
 template <typename... Tall, std::size_t... Tidx>
-constexpr auto descending_type_order_impl(std::index_sequence<Tidx...>) {
-  return std::make_tuple(type_ordering<Tall, larger_or_earlier_types<Tall...>(Tidx)>{}...);
+constexpr auto descending_type_orderings_impl(std::index_sequence<Tidx...>) {
+  return type_orderings<type_ordering<Tall, larger_or_earlier_types<Tall...>(Tidx)>...>{};
+}
+
+// Orders types by cache group (ungrouped types first), then by descending alignment within the groups
+//
+// This ordering is also the layout with the smallest size: as alignments are powers of two, and
+// sizes are multiples of the alignment, every member starts at an offset which is already aligned
+// for the next, smaller or equally aligned member. The result never contains padding between the members,
+// the only remaining padding is the tail padding required by the alignment of the entire storage,
+// and the padding before the cache groups.
+template <typename... Tall>
+constexpr auto descending_type_orderings() {
+  return descending_type_orderings_impl<Tall...>(std::make_index_sequence<sizeof...(Tall)>());
 }
 
 template <typename... Tall>
 constexpr auto descending_type_order() {
-  return descending_type_order_impl<Tall...>(std::make_index_sequence<sizeof...(Tall)>());
+  return as_tuple(descending_type_orderings<Tall...>());
 }
 
 template <typename... Tall, std::size_t... Tidx>
-constexpr auto original_type_order_impl(std::index_sequence<Tidx...>) {
-  return std::make_tuple(type_ordering<Tall, Tidx>{}...);
+constexpr auto original_type_orderings_impl(std::index_sequence<Tidx...>) {
+  return type_orderings<type_ordering<Tall, Tidx>...>{};
+}
+
+template <typename... Tall>
+constexpr auto original_type_orderings() {
+  return original_type_orderings_impl<Tall...>(std::make_index_sequence<sizeof...(Tall)>());
 }
 
 template <typename... Tall>
 constexpr auto original_type_order() {
-  return original_type_order_impl<Tall...>(std::make_index_sequence<sizeof...(Tall)>());
+  return as_tuple(original_type_orderings<Tall...>());
 }
 
 // internal helper
@@ -54,7 +154,7 @@ constexpr std::size_t idx_for_type_ordering() {
 }
 
 template <typename... Tall>  // type_ordering<T>...
-constexpr std::size_t idx_for_nth_type_in_order(std::size_t n, std::tuple<Tall...> = {}) {
+constexpr std::size_t idx_for_nth_type_in_order(std::size_t n) {
   const std::size_t idxs[] = {idx_for_type_ordering<Tall>()...};
   for (std::size_t i = 0; i < sizeof...(Tall); ++i) {
     if (idxs[i] == n) {
@@ -64,52 +164,181 @@ constexpr std::size_t idx_for_nth_type_in_order(std::size_t n, std::tuple<Tall..
   return n;  // overindexing
 }
 
-template <std::size_t N, typename... Tall>  // type_ordering<T>...
-constexpr auto type_ordering_for_nth_type_in_order(std::tuple<Tall...> = {}) {
-  constexpr std::tuple<Tall...> tup;
-  return std::get<idx_for_nth_type_in_order<Tall...>(N)>(tup);
+template <typename... Tall>  // type_ordering<T>...
+constexpr std::size_t idx_for_nth_type_in_order(std::size_t n, std::tuple<Tall...>) {
+  return idx_for_nth_type_in_order<Tall...>(n);
 }
 
+// Only names the type: constant evaluating a std::tuple<Tall...> object for every member is quadratic,
+// and dominated the compile time of large tuples
 template <std::size_t N, typename... Tall>  // type_ordering<T>...
-constexpr std::size_t sizeof_for_nth_type_in_order() {
-  return sizeof(typename decltype(type_ordering_for_nth_type_in_order<N, Tall...>())::type);
-}
+using type_ordering_for_nth_type_in_order_t = std::tuple_element_t<idx_for_nth_type_in_order<Tall...>(N), std::tuple<Tall...>>;
 
 template <std::size_t N, typename... Tall>  // type_ordering<T>...
-constexpr std::size_t alignof_for_nth_type_in_order() {
-  return alignof(typename decltype(type_ordering_for_nth_type_in_order<N, Tall...>())::type);
+constexpr auto type_ordering_for_nth_type_in_order(std::tuple<Tall...> = {}) {
+  return type_ordering_for_nth_type_in_order_t<N, Tall...>{};
 }
 
 struct order_info {
   std::size_t offset;
   std::size_t align;
   std::size_t size;
+  std::size_t group = 0;
+  bool empty = false;
 };
 
-template <typename... Tall, std::size_t... Tidx>
-constexpr std::array<order_info, sizeof...(Tall)> calculate_offsets_impl(std::index_sequence<Tidx...>) {
-  using sarr_t = std::array<order_info, sizeof...(Tall)>;
-  // non const operator = is non constexpr in std array
-  using arr_t = order_info[sizeof...(Tall)];  // std::array<order_info, sizeof...(Tall)> ;
-
-  arr_t ret = {
-      order_info{0u, alignof_for_nth_type_in_order<Tidx, Tall...>(), sizeof_for_nth_type_in_order<Tidx, Tall...>()}...};
-  for (std::size_t i = 1; i < sizeof...(Tall); ++i) {
-    ret[i].offset = ret[i - 1].offset + ret[i - 1].size;
-    if (ret[i].offset % ret[i].align != 0) {
-      ret[i].offset += ret[i].align - (ret[i].offset % ret[i].align);
+// Bitfields get zero sized slots, they are stored in separate words
+// Empty types also get zero sized slots, they are placed after the other members
+// Unaligned members are placed right after the previous member
+template <typename T>  // possibly tagged member
+constexpr order_info order_info_for_member() {
+  using traits_t = member_traits<T>;
+  constexpr bool empty = std::is_empty_v<typename traits_t::type>;
+  constexpr bool unaligned = traits_t::is_unaligned && !empty;
+  return order_info{0u, traits_t::bits != 0 || unaligned ? 1 : alignof(typename traits_t::type),
+                    traits_t::bits != 0 || empty ? 0 : sizeof(typename traits_t::type), traits_t::group,
+                    empty};
+}
+
+// The members in layout order, with their offsets
+//
+// Works on type_orderings or std::tuples of type_orderings
+template <template <typename...> typename LIST_T, typename... Tall>  // type_ordering<T>...
+constexpr std::array<order_info, sizeof...(Tall)> calculate_offsets(LIST_T<Tall...>) {
+  std::array<order_info, sizeof...(Tall)> ret{};
+  // every member goes to its position in the layout directly, without searching for the nth member
+  static_cast<void>(((ret[Tall::order] = order_info_for_member<typename Tall::type>()), ...));
+
+  // zero sized members don't occupy any bytes, they stay at the start of the storage,
+  // and don't start new cache lines (empty members are placed after the others, below)
+  const order_info* prev = nullptr;
+  for (std::size_t i = 0; i < sizeof...(Tall); ++i) {
+    if (ret[i].size == 0) {
+      continue;
+    }
+    if (prev == nullptr) {
+      prev = &ret[i];
+      continue;
+    }
+    ret[i].offset = prev->offset + prev->size;
+    // a new group (or the ungrouped members after a group) starts on a new cache line
+    const std::size_t align = ret[i].group != prev->group ? cache_line_size : ret[i].align;
+    if (ret[i].offset % align != 0) {
+      ret[i].offset += align - (ret[i].offset % align);
+    }
+    prev = &ret[i];
+  }
+
+  // Empty members are still objects, they get a byte of their own after the other members,
+  // so they are never constructed over another member, and never share an address
+  std::size_t end = prev != nullptr ? prev->offset + prev->size : 0;
+  for (std::size_t i = 0; i < sizeof...(Tall); ++i) {
+    if (!ret[i].empty) {
+      continue;
     }
+    if (end % ret[i].align != 0) {
+      end += ret[i].align - (end % ret[i].align);
+    }
+    ret[i].offset = end++;
   }
-  return sarr_t{{{ret[Tidx]}...}};
+  return ret;
 }
 
-template <typename... Tall>  // type_ordering<T>...
-constexpr std::array<std::size_t, sizeof...(Tall)> calculate_indices(std::tuple<Tall...>) {
-  return {{Tall::order...}};
+// Summary of a calculated layout
+struct layout_stats {
+  std::size_t size;     // end of the last member
+  std::size_t padding;  // bytes between the members, not used by any of them
+  std::size_t align;    // required alignment of the storage
+};
+
+template <std::size_t N>
+constexpr layout_stats calculate_layout_stats(std::array<order_info, N> const& layout) {
+  layout_stats ret{0, 0, 1};
+  for (std::size_t i = 0; i < N; ++i) {
+    if (layout[i].size == 0) {
+      ret.align = std::max(ret.align, layout[i].align);
+      continue;
+    }
+    ret.padding += layout[i].offset - ret.size;
+    ret.size = layout[i].offset + layout[i].size;
+    ret.align = std::max(ret.align, layout[i].group != 0 ? cache_line_size : layout[i].align);
+  }
+  // empty members are placed after the last byte of the other members, in layout order
+  for (std::size_t i = 0; i < N; ++i) {
+    if (layout[i].empty) {
+      ret.padding += layout[i].offset - ret.size;
+      ret.size = layout[i].offset + 1;
+    }
+  }
+  return ret;
 }
 
-template <typename... Tall>  // type_ordering<T>...
-constexpr std::array<order_info, sizeof...(Tall)> calculate_offsets(std::tuple<Tall...>) {
-  return calculate_offsets_impl<Tall...>(std::make_index_sequence<sizeof...(Tall)>());
+// Position of a bitfield member within the bit words
+struct bit_slot {
+  std::size_t word;
+  std::size_t shift;
+  std::size_t bits;  // 0 for members which aren't bitfields
+};
+
+template <template <typename...> typename LIST_T, typename... Tall>  // type_ordering<T>...
+constexpr std::array<std::size_t, sizeof...(Tall)> calculate_bits(LIST_T<Tall...>) {
+  return {{member_traits<typename Tall::type>::bits...}};
+}
+
+template <template <typename...> typename LIST_T, typename... Tall>  // type_ordering<T>...
+constexpr std::array<bool, sizeof...(Tall)> calculate_unaligned(LIST_T<Tall...>) {
+  // empty members have no bytes to copy, they are accessed directly
+  return {{(member_traits<typename Tall::type>::is_unaligned && !std::is_empty_v<member_t<typename Tall::type>>)...}};
+}
+
+template <std::size_t N>
+constexpr std::size_t calculate_total_bits(std::array<std::size_t, N> const& bits) {
+  std::size_t ret = 0;
+  for (auto b : bits) {
+    ret += b;
+  }
+  return ret;
+}
+
+// The smallest unsigned word fitting every bitfield, or uint64_t words if they don't fit into one
+template <std::size_t BITS>
+using bit_word_t = std::conditional_t<
+    BITS <= 8, std::uint8_t,
+    std::conditional_t<BITS <= 16, std::uint16_t, std::conditional_t<BITS <= 32, std::uint32_t, std::uint64_t>>>;
+
+// Assigns the bitfields to words in declaration order, a bitfield never spans two words
+template <std::size_t WORD_BITS, std::size_t N>
+constexpr std::array<bit_slot, N> calculate_bit_slots(std::array<std::size_t, N> const& bits) {
+  std::array<bit_slot, N> ret{};
+  std::size_t word = 0;
+  std::size_t shift = 0;
+  for (std::size_t i = 0; i < N; ++i) {
+    if (bits[i] == 0) {
+      continue;
+    }
+    if (shift + bits[i] > WORD_BITS) {
+      ++word;
+      shift = 0;
+    }
+    ret[i] = bit_slot{word, shift, bits[i]};
+    shift += bits[i];
+  }
+  return ret;
+}
+
+template <std::size_t N>
+constexpr std::size_t calculate_bit_word_count(std::array<bit_slot, N> const& slots) {
+  std::size_t ret = 0;
+  for (auto const& slot : slots) {
+    if (slot.bits != 0) {
+      ret = std::max(ret, slot.word + 1);
+    }
+  }
+  return ret;
+}
+
+template <template <typename...> typename LIST_T, typename... Tall>  // type_ordering<T>...
+constexpr std::array<std::size_t, sizeof...(Tall)> calculate_indices(LIST_T<Tall...>) {
+  return {{Tall::order...}};
 }
 }  // namespace tsar
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "tsar/detail/named_row.hpp"
+#include "tsar/field.hpp"
+#include "tsar/serialize.hpp"
+
+// Zero-copy, read-only access to serialized TSAR_STRUCT records
+//
+// view<foo> wraps a byte buffer (e.g. an mmapped file) and reads fields
+// directly from their compile time offsets, without constructing a foo.
+//
+// The expected layout is what tsar::serialize produces: the fields are located with
+// the same compile time plan, so the view follows the serialized format even when it
+// differs from the object representation of foo (e.g. padding or plain members between the fields).
+// Fields are read with memcpy, the buffer doesn't have to be aligned.
+//
+//   tsar::view<foo> v{bytes};
+//   int a = v->a;
+//   float c = v.get<2>();
+
+namespace tsar {
+
+// A read-only reference to a field within a byte buffer
+template <typename T>
+class view_field {
+ public:
+  explicit view_field(const std::byte* data) : data_(data) {}
+
+  T get() const {
+    std::array<std::byte, sizeof(T)> bytes;
+    std::memcpy(bytes.data(), data_, sizeof(T));
+    return std::bit_cast<T>(bytes);
+  }
+
+  operator T() const { return get(); }
+
+ private:
+  const std::byte* data_;
+};
+
+template <typename S, typename I>
+class view_impl;
+
+template <typename S, std::size_t... Is>
+class view_impl<S, std::index_sequence<Is...>> {
+  template <std::size_t IDX>
+  using meta_at_t = decltype(S::meta().template member_at<IDX>());
+
+  static_assert((... && std::is_trivially_copyable_v<typename meta_at_t<Is>::value_t>),
+                "Views can only be created for structs with trivially copyable fields");
+  static_assert((... && !meta_at_t<Is>::cold), "Cold fields aren't part of the record, they can't be viewed");
+
+ public:
+  template <std::size_t IDX>
+  using nth_type = typename meta_at_t<IDX>::value_t;
+
+  using fields_t = detail::named_row<typename meta_at_t<Is>::template named_member_t<view_field<nth_type<Is>>>...>;
+
+  // The number of bytes in a serialized record
+  static constexpr std::size_t record_size() {
+    std::size_t ret = 0;
+    for (std::size_t i = 0; i < plan.count; ++i) {
+      ret += plan.segments[i].size;
+    }
+    return ret;
+  }
+
+  // Throws std::out_of_range if the buffer is shorter than record_size()
+  explicit view_impl(std::span<const std::byte> bytes) : data_(bytes.data()) {
+    if (bytes.size() < record_size()) {
+      throw std::out_of_range("tsar::view: buffer too short");
+    }
+  }
+
+  template <std::size_t IDX>
+  nth_type<IDX> get() const {
+    return view_field<nth_type<IDX>>{data_ + record_offsets[IDX]}.get();
+  }
+
+  fields_t fields() const {
+    return fields_t{{view_field<nth_type<Is>>{data_ + record_offsets[Is]}}...};
+  }
+
+  detail::arrow_proxy<fields_t> operator->() const { return {fields()}; }
+
+ private:
+  static constexpr auto plan = serialize_detail::plan_for<S>;
+
+  // The offsets of the fields within a serialized record: the segments are written one after the other
+  static constexpr std::array<std::size_t, sizeof...(Is)> calculate_record_offsets() {
+    const std::size_t offsets[] = {S::meta().template member_at<Is>().offset()...};
+    std::array<std::size_t, sizeof...(Is)> ret{};
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < plan.count; ++i) {
+      auto const& seg = plan.segments[i];
+      const std::size_t end = i + 1 < plan.count ? plan.segments[i + 1].field : sizeof...(Is);
+      for (std::size_t f = seg.field; f < end; ++f) {
+        ret[f] = pos + offsets[f] - seg.offset;
+      }
+      pos += seg.size;
+    }
+    return ret;
+  }
+
+  static constexpr auto record_offsets = calculate_record_offsets();
+
+  const std::byte* data_;
+};
+
+template <typename S>
+class view : public view_impl<S, std::make_index_sequence<S::meta().size()>> {
+ public:
+  using view_impl<S, std::make_index_sequence<S::meta().size()>>::view_impl;
+};
+
+}  // namespace tsar
@@ -46,4 +46,43 @@ TEST_CASE("Cats make even nicer default constructible tuples") {
   auto v = t{};
   REQUIRE(v.get(marker_2{}).first() == 42);
   REQUIRE(v.size() == 2);
-}
\ No newline at end of file
+}
+namespace {
+struct marker_3 {};
+
+using mapping_t = tsar::detail::named_mapping<marker_1, marker_2, marker_3>;
+static_assert(mapping_t::index_for(marker_1{}) == 0);
+static_assert(mapping_t::index_for(marker_3{}) == 2);
+
+using key_map_t = tsar::detail::key_map<std::index_sequence<0, 1, 2>, marker_1, marker_2, marker_1>;
+static_assert(tsar::detail::unique_key_of<marker_2, key_map_t>);
+static_assert(!tsar::detail::unique_key_of<marker_1, key_map_t>);  // duplicate
+static_assert(!tsar::detail::unique_key_of<marker_3, key_map_t>);  // missing
+}  // namespace
+
+TEST_CASE("Cats find every key") {
+  using t = decltype(tsar::cat{}
+                         .add<context_aware_a>(marker_1{})
+                         .add<context_aware_a>(marker_2{})
+                         .add<context_aware_a>(marker_3{})
+                         .build());
+  auto v = t{};
+  v.get(marker_3{}).i = 3;
+  REQUIRE(v.get(marker_1{}).i == 42);
+  REQUIRE(v.get(marker_3{}).i == 3);
+  REQUIRE(v.get(marker_3{}).first() == 42);
+}
+
+using cat_added_t = decltype(tsar::cat{}.add<context_aware_a>(marker_1{}).add<context_aware_b>(marker_2{}))::tuple_t;
+using cat_of_t = tsar::cat::of<tsar::cat_entry<marker_1, context_aware_a>, tsar::cat_entry<marker_2, context_aware_b>>;
+static_assert(std::is_same_v<cat_added_t, cat_of_t>);
+static_assert(std::is_same_v<
+              decltype(tsar::cat::kittens_of<tsar::cat_entry<marker_1, context_aware_a>>{}.add<context_aware_b>(
+                  marker_2{}))::tuple_t,
+              cat_of_t>);
+
+TEST_CASE("Cats can be built in one step") {
+  auto v = cat_of_t{std::make_tuple(7), std::make_tuple(-7)};
+  REQUIRE(v.get(marker_2{}).first() == 7);
+  REQUIRE(v.get(marker_2{}).second() == -7);
+}
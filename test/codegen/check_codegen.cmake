@@ -0,0 +1,49 @@
+# Compiles the codegen kernels to assembly, and checks that every tsar_codegen_* function
+# consists of a single lea / mov with an immediate offset, followed by a ret
+#
+#   cmake -DCOMPILER=<c++> -DINCLUDE_DIR=<tsar include dir> -DSOURCE=kernels.cxx -DOUTPUT=kernels.s -P check_codegen.cmake
+
+execute_process(
+  COMMAND ${COMPILER} -std=c++20 -O2 -Wno-invalid-offsetof -fno-asynchronous-unwind-tables -fcf-protection=none
+    -I${INCLUDE_DIR} -S -o ${OUTPUT} ${SOURCE}
+  RESULT_VARIABLE result
+  ERROR_VARIABLE errors)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "Compiling ${SOURCE} failed:\n${errors}")
+endif()
+
+file(STRINGS ${SOURCE} kernel_definitions REGEX "tsar_codegen_[a-z_]+\\(")
+list(LENGTH kernel_definitions expected_count)
+
+file(STRINGS ${OUTPUT} lines)
+set(function "")
+set(failures "")
+set(checked_count 0)
+foreach(line IN LISTS lines)
+  if(line MATCHES "^(tsar_codegen_[a-z_]+):$")
+    set(function ${CMAKE_MATCH_1})
+    set(instructions "")
+  elseif(function STREQUAL "")
+    continue()
+  elseif(line MATCHES "^\t\\.size")
+    # end of the function
+    list(LENGTH instructions count)
+    list(GET instructions 0 first)
+    if(NOT count EQUAL 2 OR NOT first MATCHES "^(lea|mov)[a-z]*\t(-?[0-9]+)?\\(%[a-z0-9]+\\), %[a-z0-9]+$")
+      string(REPLACE ";" "\n    " body "${instructions}")
+      string(APPEND failures "  ${function}:\n    ${body}\n")
+    endif()
+    math(EXPR checked_count "${checked_count} + 1")
+    set(function "")
+  elseif(line MATCHES "^\t([a-z].*)$")
+    list(APPEND instructions "${CMAKE_MATCH_1}")
+  endif()
+endforeach()
+
+if(NOT failures STREQUAL "")
+  message(FATAL_ERROR "These kernels don't compile to a single lea / mov with an immediate offset:\n${failures}")
+endif()
+if(NOT checked_count EQUAL expected_count)
+  message(FATAL_ERROR "Found ${checked_count} of the ${expected_count} kernels in ${OUTPUT}")
+endif()
+message(STATUS "${checked_count} kernels compile to a single lea / mov")
@@ -0,0 +1,73 @@
+// Kernels for the codegen test, see check_codegen.cmake
+//
+// Every tsar_codegen_* function has to compile to a single lea / mov with an immediate offset, and a ret.
+// The enclosing objects are returned as void pointers, to keep the kernels extern "C".
+
+#include <string>
+
+#include "tsar/context_aware_tuple.hpp"
+#include "tsar/field.hpp"
+#include "tsar/standard_storage.hpp"
+
+template <typename WRAP_T>
+struct ctx_aware : private WRAP_T {
+  int parent_b() const { return this->enclosing().b; }
+
+  using WRAP_T::WRAP_T;
+
+  TSAR_PROTECTED_COPY_AND_MOVE(ctx_aware);
+};
+
+TSAR_STRUCT(kernel_struct) {
+  TSAR_FIELD(long, a);
+  TSAR_FIELD(int, b);
+  TSAR_FIELD(std::string, c);  // inheritance wrap
+  TSAR_FIELD_T(ctx_aware, d);
+};
+
+using composition_t = decltype(kernel_struct::b);
+using inheritance_t = decltype(kernel_struct::c);
+using context_aware_field_t = decltype(kernel_struct::d);
+
+template <typename CTX>
+struct context_aware_item {
+  int i;
+
+  auto& container() { return CTX::container(this); }
+  auto const& container() const { return CTX::container(this); }
+};
+
+using context_aware_tuple_t = tsar::context_aware_tuple<context_aware_item, context_aware_item>;
+using context_aware_item_t = std::remove_reference_t<decltype(std::declval<context_aware_tuple_t&>().get<1>())>;
+
+using storage_t = tsar::standard_storage<tsar::ordering::optimal, char, int, double>;
+
+extern "C" {
+
+void* tsar_codegen_composition_enclosing(composition_t* f) { return &f->enclosing(); }
+
+void const* tsar_codegen_composition_enclosing_const(composition_t const* f) { return &f->enclosing(); }
+
+void* tsar_codegen_inheritance_enclosing(inheritance_t* f) { return &f->enclosing(); }
+
+void const* tsar_codegen_inheritance_enclosing_const(inheritance_t const* f) { return &f->enclosing(); }
+
+void* tsar_codegen_wrap_t_enclosing(context_aware_field_t* f) { return &f->enclosing(); }
+
+void const* tsar_codegen_wrap_t_enclosing_const(context_aware_field_t const* f) { return &f->enclosing(); }
+
+// wrap_magic::enclosing(), called by the context aware type itself
+int tsar_codegen_wrap_magic_load(context_aware_field_t const* f) { return f->parent_b(); }
+
+long tsar_codegen_field_load(composition_t const* f) { return f->enclosing().a; }
+
+void* tsar_codegen_context_aware_container(context_aware_item_t* item) { return &item->container(); }
+
+void const* tsar_codegen_context_aware_container_const(context_aware_item_t const* item) {
+  return &item->container();
+}
+
+int* tsar_codegen_storage_get(storage_t* s) { return &s->get<1>(); }
+
+int tsar_codegen_storage_load(storage_t const* s) { return s->get<1>(); }
+}
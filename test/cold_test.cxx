@@ -0,0 +1,113 @@
+#include "tsar/cold.hpp"
+
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "tsar/dirty.hpp"
+#include "tsar/serialize.hpp"
+
+using namespace tsar;
+
+namespace {
+
+TSAR_STRUCT(entity) {
+  TSAR_FIELD(float, x);
+  TSAR_FIELD(float, y);
+  TSAR_COLD_FIELD(std::string, debug_name);
+  TSAR_COLD_FIELD(int, spawn_tick);
+
+  TSAR_COLD_STORAGE();
+};
+
+TSAR_STRUCT(hot_only) {
+  TSAR_FIELD(float, x);
+  TSAR_FIELD(float, y);
+};
+
+}  // namespace
+
+static_assert(sizeof(entity) == sizeof(hot_only) + sizeof(void*));
+static_assert(entity::meta().size() == 4);
+static_assert(!decltype(entity::meta().member_at<1>())::cold);
+static_assert(decltype(entity::meta().member_at<2>())::cold);
+
+TEST_CASE("Cold fields are allocated on the first write") {
+  entity e{};
+  e.x = 1.0f;
+  REQUIRE(!e.tsar_cold.allocated());
+
+  auto const& ce = e;
+  REQUIRE(ce.debug_name.get().empty());
+  REQUIRE(ce.spawn_tick.get() == 0);
+  REQUIRE(!e.tsar_cold.allocated());
+
+  e.debug_name = std::string{"player"};
+  e.spawn_tick = 42;
+  REQUIRE(e.tsar_cold.allocated());
+  REQUIRE(e.debug_name->size() == 6);
+  REQUIRE(e.spawn_tick.get() == 42);
+  REQUIRE(e.x == 1.0f);
+}
+
+TEST_CASE("Cold fields are copied and moved with the struct") {
+  entity e{};
+  e.debug_name = std::string{"original"};
+
+  entity copy{e};
+  copy.debug_name = std::string{"copy"};
+  REQUIRE(e.debug_name.get() == "original");
+  REQUIRE(copy.debug_name.get() == "copy");
+
+  entity moved{std::move(copy)};
+  REQUIRE(moved.debug_name.get() == "copy");
+
+  std::vector<entity> v(3);
+  v[1].spawn_tick = 7;
+  v.resize(10);
+  REQUIRE(v[1].spawn_tick.get() == 7);
+  REQUIRE(!v[0].tsar_cold.allocated());
+}
+
+TEST_CASE("Cold fields are accessible through the metadata") {
+  entity e{};
+  e.x = 2.0f;
+  e.debug_name = std::string{"meta"};
+
+  REQUIRE(entity::meta().find("debug_name") == 2);
+  REQUIRE(decltype(entity::meta().member_at<2>())::access(e) == "meta");
+}
+
+TEST_CASE("Cold fields are serialized") {
+  entity e{};
+  e.x = 1.0f;
+  e.y = 2.0f;
+  e.debug_name = std::string{"saved"};
+  e.spawn_tick = 3;
+
+  std::vector<std::byte> bytes;
+  serialize(e, bytes);
+
+  entity r{};
+  REQUIRE(deserialize(r, bytes) == bytes.size());
+  REQUIRE(r.x == 1.0f);
+  REQUIRE(r.y == 2.0f);
+  REQUIRE(r.debug_name.get() == "saved");
+  REQUIRE(r.spawn_tick.get() == 3);
+}
+
+TEST_CASE("Cold fields can be dirty tracked") {
+  TSAR_STRUCT(local) {
+    TSAR_FIELD(int, a);
+    TSAR_COLD_FIELD(int, b);
+
+    TSAR_COLD_STORAGE();
+    TSAR_DIRTY_TRACKING();
+  };
+
+  local l{};
+  l.b = 4;
+  REQUIRE(l.tsar_dirty.count() == 1);
+  REQUIRE(l.tsar_dirty.test(1));
+  REQUIRE(l.b.get() == 4);
+}
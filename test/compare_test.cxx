@@ -0,0 +1,75 @@
+#include "tsar/compare.hpp"
+
+#include <string>
+#include <unordered_set>
+
+#include "catch.hpp"
+
+using namespace tsar;
+
+namespace {
+
+TSAR_STRUCT(key) {
+  TSAR_FIELD(int, a);
+  TSAR_FIELD(int, b);
+  TSAR_FIELD(long, c);
+};
+
+TSAR_STRUCT(padded_key) {
+  TSAR_FIELD(char, a);
+  TSAR_FIELD(int, b);
+};
+
+TSAR_STRUCT(named) {
+  TSAR_FIELD(std::string, name);
+  TSAR_FIELD(double, weight);
+};
+
+}  // namespace
+
+static_assert(compare_detail::bytewise_comparable_v<key>);
+static_assert(!compare_detail::bytewise_comparable_v<padded_key>);
+static_assert(!compare_detail::bytewise_comparable_v<named>);
+
+TEST_CASE("Structs without padding are compared and hashed bytewise") {
+  key k1{};
+  k1.a = 1;
+  k1.b = 2;
+  k1.c = 3;
+  key k2{k1};
+
+  REQUIRE(equal(k1, k2));
+  REQUIRE(hash_value(k1) == hash_value(k2));
+  REQUIRE(std::is_eq(compare(k1, k2)));
+
+  k2.b = 1;
+  REQUIRE(!equal(k1, k2));
+  REQUIRE(std::is_gt(compare(k1, k2)));
+  REQUIRE(hash_value(k1) != hash_value(k2));
+}
+
+TEST_CASE("Structs with padding are compared field by field") {
+  padded_key k1{};
+  padded_key k2{};
+  k1.a = 'x';
+  k2.a = 'x';
+  // the padding bytes may differ, but the values don't
+  reinterpret_cast<char*>(&static_cast<padded_key::struct_t&>(k2))[1] = 42;
+
+  REQUIRE(equal(k1, k2));
+  REQUIRE(hash_value(k1) == hash_value(k2));
+}
+
+TEST_CASE("Structs can be used as unordered keys") {
+  std::unordered_set<named, struct_hash, struct_equal_to> set;
+
+  named n{};
+  n.name = std::string{"a"};
+  set.insert(n);
+  set.insert(n);
+  n.weight = 1.5;
+  set.insert(n);
+
+  REQUIRE(set.size() == 2);
+  REQUIRE(std::is_eq(compare(*set.begin(), *set.begin())));
+}
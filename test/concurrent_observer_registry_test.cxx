@@ -0,0 +1,91 @@
+#include "catch.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "tsar/cat.hpp"
+#include "tsar/observable/concurrent_observer_registry.hpp"
+#include "tsar/observable/observable.hpp"
+
+using namespace tsar::observable;
+
+namespace {
+
+struct marker_1 {};
+struct marker_2 {};
+
+struct counting_observer : public observer_t<int> {
+  std::atomic<int> events{0};
+  void on_changed(int const& /* unused */) override { events++; }
+};
+
+}  // namespace
+
+TEST_CASE("Concurrent registries work like the default registry") {
+  auto o = tsar::cat{}
+               .add<concurrent_observer_registry>(observer_registry_marker{})
+               .add<observable<int>::type>(marker_1{})
+               .add<observable<int>::type>(marker_2{})
+               .build();
+
+  counting_observer observer1;
+  counting_observer observer2;
+
+  o.get(marker_1{}).observe(observer1);
+  o.get(marker_2{}).observe(observer2);
+
+  o.get(marker_1{}) = 1;
+  o.get(marker_1{}) = 2;
+  o.get(marker_2{}) = 3;
+  o.get(marker_1{}).unobserve(observer1);
+  o.get(marker_1{}) = 4;
+
+  REQUIRE(observer1.events == 2);
+  REQUIRE(observer2.events == 1);
+}
+
+TEST_CASE("Concurrent registries allow subscribing while other threads fire") {
+  auto o = tsar::cat{}
+               .add<concurrent_observer_registry>(observer_registry_marker{})
+               .add<observable<int>::type>(marker_1{})
+               .add<observable<int>::type>(marker_2{})
+               .build();
+
+  counting_observer stable;
+  o.get(marker_2{}).observe(stable);
+
+  constexpr int writes = 20000;
+  std::atomic<bool> done{false};
+
+  std::thread subscriber{[&]() {
+    while (!done) {
+      auto* temporary = new counting_observer;
+      o.get(marker_1{}).observe(*temporary);
+      o.get(marker_2{}).observe(*temporary);
+      o.get(marker_2{}).unobserve(*temporary);
+      o.get(marker_1{}).unobserve(*temporary);
+      // safe, as unobserve waits for every fire that could still see the observer
+      delete temporary;
+    }
+  }};
+
+  std::thread writer_1{[&]() {
+    for (int i = 1; i <= writes; ++i) {
+      o.get(marker_1{}) = i;
+    }
+  }};
+
+  std::thread writer_2{[&]() {
+    for (int i = 1; i <= writes; ++i) {
+      o.get(marker_2{}) = i;
+    }
+  }};
+
+  writer_1.join();
+  writer_2.join();
+  done = true;
+  subscriber.join();
+
+  REQUIRE(stable.events == writes);
+}
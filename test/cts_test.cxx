@@ -4,6 +4,11 @@
 #include "catch.hpp"
 #include <iostream>
 #include <cstring>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "tsar/switch_on.hpp"
 
 using namespace tsar;
 
@@ -31,3 +36,47 @@ TEST_CASE("CTS contains the correct value") {
   REQUIRE(strcmp("asdf", s2.get().c_str()) == 0);
 }
 
+
+static_assert("asdf"_s.hash() == detail::hash_string("asdf"));
+static_assert(""_s.hash() == 0xcbf29ce484222325ull);
+
+static_assert(intern<"foo"_s>() == intern<"foo"_s>());
+static_assert(intern<"foo"_s>().name() == "foo");
+
+TEST_CASE("Interned ids can be hashed") {
+  REQUIRE(intern<"foo"_s>() != intern<"bar"_s>());
+
+  std::unordered_set<cts_id> ids{intern<"a"_s>(), intern<"b"_s>(), intern<"a"_s>()};
+  REQUIRE(ids.size() == 2);
+  REQUIRE(ids.contains(intern<"b"_s>()));
+}
+
+namespace {
+constexpr int command_code(std::string_view command) {
+  return switch_on(command,
+                   on<"start"_s>([] { return 1; }),
+                   on<"stop"_s>([] { return 2; }),
+                   on<"restart"_s>([] { return 3; }),
+                   otherwise([] { return -1; }));
+}
+}  // namespace
+
+static_assert(command_code("start") == 1);
+static_assert(command_code("restart") == 3);
+static_assert(command_code("pause") == -1);
+static_assert(command_code("") == -1);
+
+TEST_CASE("Strings can be switched on") {
+  std::vector<std::string> calls;
+  for (std::string command : {"stop", "start", "halt", "sto"}) {
+    switch_on(command,
+              on<"start"_s>([&] { calls.push_back("started"); }),
+              on<"stop"_s>([&] { calls.push_back("stopped"); }),
+              otherwise([&] { calls.push_back("unknown " + command); }));
+  }
+  REQUIRE(calls == std::vector<std::string>{"stopped", "started", "unknown halt", "unknown sto"});
+
+  // without otherwise, missing values return a value initialized result
+  REQUIRE(switch_on("x", on<"y"_s>([] { return 42; })) == 0);
+  REQUIRE(switch_on("y", on<"y"_s>([] { return 42; })) == 42);
+}
@@ -0,0 +1,91 @@
+#include "tsar/dirty.hpp"
+
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace tsar;
+
+namespace {
+
+TSAR_STRUCT(account) {
+  TSAR_FIELD(int, id);
+  TSAR_FIELD(std::string, owner);
+  TSAR_FIELD(double, balance);
+
+  TSAR_DIRTY_TRACKING();
+};
+
+}  // namespace
+
+static_assert(decltype(account::tsar_dirty)::size() == 3);
+
+TEST_CASE("Assignments mark fields as dirty") {
+  account a{};
+  REQUIRE(!a.tsar_dirty.any());
+
+  a.balance = 10.0;
+  a.owner = std::string{"someone"};
+
+  REQUIRE(a.tsar_dirty.count() == 2);
+  REQUIRE(!a.tsar_dirty.test(0));
+  REQUIRE(a.tsar_dirty.test(1));
+  REQUIRE(a.tsar_dirty.test(2));
+
+  std::vector<std::string_view> names;
+  for_each_dirty(a, [&](auto meta, auto& /* unused */) { names.push_back(meta.name_view()); });
+  REQUIRE(names == std::vector<std::string_view>{"owner", "balance"});
+
+  a.tsar_dirty.clear();
+  REQUIRE(!a.tsar_dirty.any());
+}
+
+TEST_CASE("Compound assignments and increments mark fields as dirty") {
+  account a{};
+  a.id += 5;
+  REQUIRE(a.tsar_dirty.test(0));
+  REQUIRE(a.tsar_dirty.count() == 1);
+
+  a.tsar_dirty.clear();
+  ++a.id;
+  REQUIRE(a.tsar_dirty.test(0));
+  REQUIRE(a.id == 6);
+
+  a.tsar_dirty.clear();
+  REQUIRE(a.id-- == 6);
+  REQUIRE(a.tsar_dirty.test(0));
+  REQUIRE(a.id == 5);
+
+  a.owner += "x";
+  a.balance *= 2.0;
+  REQUIRE(a.tsar_dirty.count() == 3);
+  REQUIRE(static_cast<std::string const&>(a.owner) == "x");
+
+  a.tsar_dirty.clear();
+  a.owner += {'y', 'z'};
+  REQUIRE(a.tsar_dirty.test(1));
+  REQUIRE(static_cast<std::string const&>(a.owner) == "xyz");
+}
+
+TEST_CASE("Dirty fields can be visited with their values") {
+  TSAR_STRUCT(local) {
+    TSAR_FIELD(int, a);
+    TSAR_FIELD(int, b);
+
+    TSAR_DIRTY_TRACKING();
+  };
+
+  local l{};
+  l.b = 4;
+
+  int sum = 0;
+  for_each_dirty(l, [&](auto /* unused */, int& value) { sum += value; });
+  REQUIRE(sum == 4);
+
+  int& ref = l.a;
+  ref = 5;
+  REQUIRE(!l.tsar_dirty.test(0));
+  l.tsar_dirty.mark<0>();
+  REQUIRE(l.tsar_dirty.test(0));
+}
@@ -102,6 +102,15 @@ TEST_CASE("Fields work with some pointer magic") {
   REQUIRE(a == 30);
 }
 
+TEST_CASE("Fields find their enclosing struct through const references") {
+  foo f1{};
+  foo const& cf = f1;
+
+  REQUIRE(&cf.a.enclosing() == &f1.a.enclosing());  // composition
+  REQUIRE(&cf.b.enclosing() == &f1.a.enclosing());  // inheritance
+  REQUIRE(&cf.c.enclosing() == &f1.a.enclosing());
+}
+
 template <typename WRAP_T>
 struct ctx_aware : private WRAP_T {
   int get_parent_a() {  // not constexpr :(
@@ -145,3 +154,54 @@ TEST_CASE("Containing type awareness and copies") {
 
   REQUIRE(f.b.get_parent_a() == 10);
 }
+
+static_assert(foo::meta().find("a") == 0);
+static_assert(foo::meta().find("c") == 2);
+static_assert(!foo::meta().find("d").has_value());
+
+TEST_CASE("Fields can be found by their runtime name") {
+  TSAR_STRUCT(wide) {
+    TSAR_FIELD(int, id);
+    TSAR_FIELD(int, name);
+    TSAR_FIELD(int, created_at);
+    TSAR_FIELD(int, updated_at);
+    TSAR_FIELD(int, owner);
+    TSAR_FIELD(int, group);
+    TSAR_FIELD(int, status);
+    TSAR_FIELD(int, priority);
+    TSAR_FIELD(int, x);
+    TSAR_FIELD(int, y);
+    TSAR_FIELD(int, z);
+  };
+
+  const std::string_view names[] = {"id", "name",     "created_at", "updated_at", "owner", "group",
+                                    "status", "priority", "x",          "y",          "z"};
+  for (std::size_t i = 0; i < std::size(names); ++i) {
+    REQUIRE(wide::meta().find(names[i]) == i);
+  }
+
+  REQUIRE(!wide::meta().find("").has_value());
+  REQUIRE(!wide::meta().find("i").has_value());
+  REQUIRE(!wide::meta().find("idx").has_value());
+  REQUIRE(!wide::meta().find("priority2").has_value());
+}
+
+TEST_CASE("Cache line fields start new cache lines") {
+  TSAR_STRUCT(counters) {
+    TSAR_FIELD(int, config);
+    TSAR_CACHE_LINE_FIELD(long, produced) = 1;
+    TSAR_FIELD(long, produced_bytes);
+    TSAR_CACHE_LINE_FIELD(long, consumed);
+  };
+
+  static_assert(counters::meta().size() == 4);
+  static_assert(counters::meta().member_at<1>().offset() == cache_line_size);
+  static_assert(counters::meta().member_at<2>().offset() == cache_line_size + sizeof(long));
+  static_assert(counters::meta().member_at<3>().offset() == 2 * cache_line_size);
+  static_assert(sizeof(counters) == 3 * cache_line_size);
+
+  counters c{};
+  c.consumed = 2;
+  REQUIRE(c.produced == 1);
+  REQUIRE(c.consumed == 2);
+}
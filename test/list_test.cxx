@@ -66,3 +66,20 @@ static_assert(equals<for_each<A_LIST, to_array>().size(), 2>());
 
 // with a lambda!
 static_assert(equals<for_each<A_LIST>([](auto... args){ return sizeof...(args); }), 2>());
+
+// Frozen lists keep the size of the list at the point of the freeze
+struct FROZEN_LIST {};
+
+struct F1 : public link<FROZEN_LIST, F1> {};
+struct F2 : public link<FROZEN_LIST, F2> {};
+
+static constexpr auto frozen_list = freeze<FROZEN_LIST>();
+
+struct F3 : public link<FROZEN_LIST, F3> {};
+
+static_assert(equals<frozen_list.size(), 2>());
+static_assert(equals<size(FROZEN_LIST{}, []() {}), 3>());
+static_assert(std::is_same_v<decltype(frozen_list.at<0>()), F1*>);
+static_assert(std::is_same_v<decltype(frozen_list.at<1>()), F2*>);
+static_assert(equals<frozen_list.for_each([](auto... args) { return sizeof...(args); }), 2>());
+static_assert(equals<freeze<FROZEN_LIST>().size(), 3>());
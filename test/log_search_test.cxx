@@ -1,5 +1,7 @@
 #include "tsar/log_search.hpp"
 
+#include <algorithm>
+
 #include "tsar/assert.hpp"
 using namespace tsar::assert;
 
@@ -67,3 +69,27 @@ static_assert(
     equals<tsar::log_search_v(
                []<std::size_t Idx, typename Id>() consteval { return Idx < 100; }, static_cast<Id1*>(nullptr)),
            100>());
+
+// Tests about log_search_sorted
+// ========================================
+
+template <std::size_t N>
+constexpr bool sorted_search_matches_lower_bound() {
+  std::array<int, N> items{};
+  for (std::size_t i = 0; i < N; ++i) {
+    items[i] = static_cast<int>(i * 2);
+  }
+  for (int v = -1; v <= static_cast<int>(N * 2); ++v) {
+    if (tsar::log_search_sorted(items, v) != static_cast<std::size_t>(std::lower_bound(items.begin(), items.end(), v) - items.begin())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(sorted_search_matches_lower_bound<0>());
+static_assert(sorted_search_matches_lower_bound<1>());
+static_assert(sorted_search_matches_lower_bound<2>());
+static_assert(sorted_search_matches_lower_bound<7>());
+static_assert(sorted_search_matches_lower_bound<64>());
+static_assert(sorted_search_matches_lower_bound<100>());
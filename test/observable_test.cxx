@@ -1,6 +1,7 @@
 
 #include "catch.hpp"
 
+#include <stdexcept>
 #include <vector>
 
 #include "tsar/cat.hpp"
@@ -60,6 +61,9 @@ TEST_CASE("Observable composite types fire on change") {
                         .add<observable<o_pos, friendly_pos>::type>(marker_2{})
                         .build();
 
+  // the observer_forwarder of the nested composite is empty, it only takes a byte after the members
+  REQUIRE(sizeof(o_with_pos.get(marker_1{})) == 3 * sizeof(o_with_pos.get(marker_1{}).get(marker_x{})));
+
   {
     auto observer1 = binding<my_observer<int>>(o_with_pos.get(marker_1{}).get(marker_x{}));
     auto observer2 = binding<my_observer<int>>(o_with_pos.get(marker_1{}).get(marker_x{}));
@@ -102,3 +106,109 @@ TEST_CASE("Strings can be observed") {
     REQUIRE(observer1.observer().events == std::vector<std::string>{"foo", "bar", "foo"});
   }
 }
+
+TEST_CASE("Observers can be removed independently of other items") {
+  auto o = tsar::cat{}
+               .add<observer_registry>(observer_registry_marker{})
+               .add<observable<int>::type>(marker_1{})
+               .add<observable<int>::type>(marker_2{})
+               .build();
+
+  my_observer<int> observer1;
+  my_observer<int> observer2;
+
+  o.get(marker_2{}).observe(observer2);
+  o.get(marker_1{}).observe(observer1);
+  o.get(marker_2{}).observe(observer1);
+
+  o.get(marker_2{}) = 1;
+  o.get(marker_1{}).unobserve(observer1);
+  o.get(marker_1{}) = 2;
+  o.get(marker_2{}) = 3;
+  o.get(marker_2{}).unobserve(observer1);
+  o.get(marker_2{}).unobserve(observer2);
+  o.get(marker_2{}) = 4;
+
+  REQUIRE(observer1.events == std::vector<int>{1, 3});
+  REQUIRE(observer2.events == std::vector<int>{1, 3});
+}
+
+TEST_CASE("Batches fire each changed item once, with the final value") {
+  auto o = tsar::cat{}
+               .add<observer_registry>(observer_registry_marker{})
+               .add<observable<int>::type>(marker_1{})
+               .add<observable<int>::type>(marker_2{})
+               .build();
+
+  auto observer1 = binding<my_observer<int>>(o.get(marker_1{}));
+  auto observer2 = binding<my_observer<int>>(o.get(marker_2{}));
+
+  {
+    auto tx = o.get(observer_registry_marker{}).begin_batch();
+    for (int i = 0; i < 100; ++i) {
+      o.get(marker_1{}) = i;
+    }
+
+    {
+      auto nested = o.get(observer_registry_marker{}).begin_batch();
+      o.get(marker_2{}) = 5;
+    }
+
+    REQUIRE(observer1.observer().events.empty());
+    REQUIRE(observer2.observer().events.empty());
+  }
+
+  REQUIRE(observer1.observer().events == std::vector<int>{99});
+  REQUIRE(observer2.observer().events == std::vector<int>{5});
+
+  o.get(marker_1{}) = 1;
+  REQUIRE(observer1.observer().events == std::vector<int>{99, 1});
+}
+
+struct throwing_observer : public observer_t<int> {
+  void on_changed(int const& /* unused */) override { throw std::runtime_error("observer failed"); }
+};
+
+TEST_CASE("Batch commits propagate observer exceptions, destructors swallow them") {
+  auto o = tsar::cat{}
+               .add<observer_registry>(observer_registry_marker{})
+               .add<observable<int>::type>(marker_1{})
+               .build();
+
+  auto observer = binding<throwing_observer>(o.get(marker_1{}));
+
+  {
+    auto tx = o.get(observer_registry_marker{}).begin_batch();
+    o.get(marker_1{}) = 1;
+    REQUIRE_THROWS_AS(tx.commit(), std::runtime_error);
+  }
+
+  {
+    auto tx = o.get(observer_registry_marker{}).begin_batch();
+    o.get(marker_1{}) = 2;
+  }
+
+  REQUIRE_THROWS_AS(o.get(marker_1{}) = 3, std::runtime_error);
+}
+
+TEST_CASE("Batches work with composite types") {
+  using o_pos = decltype(tsar::cat{}.add<observable<int>::type>(marker_x{}).add<observable<int>::type>(marker_y{}));
+
+  auto o = tsar::cat{}
+               .add<observer_registry>(observer_registry_marker{})
+               .add<observable<o_pos, friendly_pos>::type>(marker_1{})
+               .build();
+
+  auto observer_x = binding<my_observer<int>>(o.get(marker_1{}).x());
+  auto observer_y = binding<my_observer<int>>(o.get(marker_1{}).y());
+
+  {
+    auto tx = o.get(observer_registry_marker{}).begin_batch();
+    o.get(marker_1{}).x() = 1;
+    o.get(marker_1{}).y() = 2;
+    o.get(marker_1{}).x() = 3;
+  }
+
+  REQUIRE(observer_x.observer().events == std::vector<int>{3});
+  REQUIRE(observer_y.observer().events == std::vector<int>{2});
+}
@@ -0,0 +1,39 @@
+#include "tsar/detail/perfect_hash.hpp"
+
+#include "tsar/assert.hpp"
+
+using namespace tsar::assert;
+using namespace tsar::detail;
+
+template <std::size_t N>
+constexpr std::array<std::uint64_t, N> sequential_hashes() {
+  std::array<std::uint64_t, N> ret{};
+  for (std::size_t i = 0; i < N; ++i) {
+    ret[i] = hash_mix(i) ^ i;
+  }
+  return ret;
+}
+
+template <std::size_t N>
+constexpr bool finds_every_key() {
+  constexpr auto hashes = sequential_hashes<N>();
+  constexpr auto table = make_perfect_hash(hashes);
+  for (std::size_t i = 0; i < N; ++i) {
+    if (table.find(hashes[i]) != i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(finds_every_key<0>());
+static_assert(finds_every_key<1>());
+static_assert(finds_every_key<2>());
+static_assert(finds_every_key<17>());
+static_assert(finds_every_key<300>());
+
+static_assert(equals<perfect_hash<300>::table_size, 1024>());
+static_assert(equals<perfect_hash<0>::table_size, 2>());
+
+static_assert(hash_string("") == 0xcbf29ce484222325ull);
+static_assert(hash_string("a") == 0xaf63dc4c8601ec8cull);
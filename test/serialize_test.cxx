@@ -0,0 +1,113 @@
+#include "tsar/serialize.hpp"
+
+#include "catch.hpp"
+
+using namespace tsar;
+
+namespace {
+
+TSAR_STRUCT(row) {
+  TSAR_FIELD(int, id);
+  TSAR_FIELD(short, kind);
+  TSAR_FIELD(double, value);
+  TSAR_FIELD(std::string, name);
+  TSAR_FIELD(int, flags);
+  TSAR_FIELD(char, tag);
+};
+
+TSAR_STRUCT(outer) {
+  TSAR_FIELD(int, version);
+  TSAR_FIELD(row, inner);
+};
+
+TSAR_STRUCT(gapped) {
+  TSAR_FIELD(short, a);
+  char plain;  // not a field, sits in the gap before b
+  TSAR_FIELD(int, b);
+};
+
+}  // namespace
+
+// id and kind are merged into a single range, value isn't merged over the padding after kind
+static_assert(serialize_detail::plan_for<row>.count == 4);
+static_assert(serialize_detail::plan_for<row>.segments[0].offset == 0);
+static_assert(serialize_detail::plan_for<row>.segments[0].size == 6);
+static_assert(serialize_detail::plan_for<row>.segments[1].field == 2);
+static_assert(!serialize_detail::plan_for<row>.segments[2].trivial);
+static_assert(serialize_detail::plan_for<row>.segments[3].field == 4);
+static_assert(serialize_detail::plan_for<row>.segments[3].size == 5);
+
+// plain fits into the gap before b, even though b starts at the next aligned offset after a
+static_assert(serialize_detail::plan_for<gapped>.count == 2);
+
+TEST_CASE("Structs can be serialized and deserialized") {
+  row r{};
+  r.id = 42;
+  r.kind = 3;
+  r.value = 2.5;
+  r.name = "hello";
+  r.flags = 7;
+  r.tag = 'x';
+
+  std::vector<std::byte> buffer;
+  serialize(r, buffer);
+
+  REQUIRE(buffer.size() == 6 + 8 + 8 + 5 + 5);
+
+  row r2{};
+  REQUIRE(deserialize(r2, buffer) == buffer.size());
+  REQUIRE(r2.id == 42);
+  REQUIRE(r2.kind == 3);
+  REQUIRE(r2.value == 2.5);
+  REQUIRE(static_cast<std::string const&>(r2.name) == "hello");
+  REQUIRE(r2.flags == 7);
+  REQUIRE(r2.tag == 'x');
+}
+
+TEST_CASE("Serialization appends to the buffer and handles nested structs") {
+  outer o{};
+  o.version = 2;
+  o.inner.id = 5;
+  o.inner.name = "nested";
+
+  std::vector<std::byte> buffer;
+  serialize(o, buffer);
+  serialize(o, buffer);
+
+  outer o2{};
+  const auto consumed = deserialize(o2, buffer);
+  REQUIRE(consumed * 2 == buffer.size());
+  REQUIRE(o2.version == 2);
+  REQUIRE(o2.inner.id == 5);
+  REQUIRE(static_cast<std::string const&>(o2.inner.name) == "nested");
+}
+
+TEST_CASE("Deserialization fails on truncated buffers") {
+  row r{};
+  r.name = "truncated";
+
+  std::vector<std::byte> buffer;
+  serialize(r, buffer);
+  buffer.resize(buffer.size() - 8);
+
+  row r2{};
+  REQUIRE_THROWS_AS(deserialize(r2, buffer), std::out_of_range);
+}
+
+TEST_CASE("Deserialization doesn't overwrite plain members between the fields") {
+  gapped g{};
+  g.a = 1;
+  g.plain = 'Q';
+  g.b = 2;
+
+  std::vector<std::byte> buffer;
+  serialize(g, buffer);
+  REQUIRE(buffer.size() == sizeof(short) + sizeof(int));
+
+  gapped g2{};
+  g2.plain = 'K';
+  REQUIRE(deserialize(g2, buffer) == buffer.size());
+  REQUIRE(g2.a == 1);
+  REQUIRE(g2.b == 2);
+  REQUIRE(g2.plain == 'K');
+}
@@ -0,0 +1,112 @@
+#include "tsar/soa_vector.hpp"
+
+#include <numeric>
+#include <stdexcept>
+
+#include "catch.hpp"
+
+using namespace tsar;
+
+namespace {
+
+TSAR_STRUCT(particle) {
+  TSAR_FIELD(int, id);
+  TSAR_FIELD(double, x) = 1.5;
+  TSAR_FIELD(bool, alive);
+};
+
+struct throwing_copy {
+  bool fail = false;
+
+  throwing_copy() = default;
+  explicit throwing_copy(bool f) : fail(f) {}
+  throwing_copy(throwing_copy const& o) : fail(o.fail) {
+    if (fail) {
+      throw std::runtime_error("copy failed");
+    }
+  }
+  throwing_copy& operator=(throwing_copy const&) = default;
+};
+
+TSAR_STRUCT(fragile) {
+  TSAR_FIELD(int, id);
+  TSAR_FIELD(throwing_copy, payload);
+  TSAR_FIELD(int, tail);
+};
+
+}  // namespace
+
+static_assert(std::is_same_v<soa_vector<particle>::column_t<1>, std::vector<double>>);
+
+TEST_CASE("Structure of arrays stores fields in separate columns") {
+  soa_vector<particle> v;
+
+  particle p{};
+  p.id = 1;
+  v.push_back(p);
+  p.id = 2;
+  p.x = 2.5;
+  v.push_back(p);
+  v.emplace_back(3, 3.5, true);
+
+  REQUIRE(v.size() == 3);
+  REQUIRE(v.column<0>() == std::vector<int>{1, 2, 3});
+  REQUIRE(v.column<1>() == std::vector<double>{1.5, 2.5, 3.5});
+  REQUIRE(std::accumulate(v.column<1>().begin(), v.column<1>().end(), 0.0) == 7.5);
+}
+
+TEST_CASE("Structure of arrays rows have the field names of the struct") {
+  soa_vector<particle> v;
+  v.emplace_back(1, 1.0, false);
+  v.emplace_back(2, 2.0, false);
+
+  v[1].x = 4.0;
+  v[1].alive = true;
+
+  REQUIRE(v[1].id == 2);
+  REQUIRE(v.column<1>()[1] == 4.0);
+  REQUIRE(v.column<2>()[1]);
+
+  auto const& cv = v;
+  REQUIRE(cv[0].x == 1.0);
+
+  int sum = 0;
+  for (auto row : v) {
+    sum += row.id;
+    row.alive = true;
+  }
+  REQUIRE(sum == 3);
+  REQUIRE(v.column<2>() == std::vector<bool>{true, true});
+}
+
+TEST_CASE("Structure of arrays works with local types") {
+  TSAR_STRUCT(local) {
+    TSAR_FIELD(int, a);
+    TSAR_FIELD(float, b);
+  };
+
+  soa_vector<local> v;
+  v.emplace_back(5, 1.0f);
+  v[0].a += 1;
+
+  REQUIRE(v[0].a == 6);
+  REQUIRE(v.column<1>().size() == 1);
+}
+
+TEST_CASE("Structure of arrays keeps the columns in sync when appending throws") {
+  soa_vector<fragile> v;
+  v.emplace_back(1, throwing_copy{}, 1);
+
+  fragile f{};
+  f.id = 2;
+  f.payload = throwing_copy{true};
+  REQUIRE_THROWS_AS(v.push_back(f), std::runtime_error);
+
+  const throwing_copy bad{true};
+  REQUIRE_THROWS_AS(v.emplace_back(3, bad, 3), std::runtime_error);
+
+  REQUIRE(v.size() == 1);
+  REQUIRE(v.column<0>().size() == 1);
+  REQUIRE(v.column<1>().size() == 1);
+  REQUIRE(v.column<2>().size() == 1);
+}
@@ -3,7 +3,10 @@
 
 #include <functional>
 #include <iostream>
+#include <type_traits>
+#include <vector>
 
+#include "tsar/st.hpp"
 #include "tsar/standard_tuple.hpp"
 #include "tsar/typewrap_literals.hpp"
 
@@ -278,3 +281,146 @@ TEST_CASE("Standard tuple can be non equal compared") {
   REQUIRE(other_tup != tup);
   REQUIRE(call_count == 1);
 }
+
+namespace {
+enum class color : unsigned char { red, green, blue };
+}
+
+using flags_t = tsar::bitpacked_standard_tuple<int, bool, bool, tsar::bitfield<color, 2>, short, bool>;
+static_assert(sizeof(flags_t) == 8, "Bools and bitfields share a single word");
+static_assert(sizeof(tsar::sorted_standard_tuple<int, bool, bool, color, short, bool>) == 12);
+static_assert(std::is_same_v<flags_t::nth_type<3>, color>);
+static_assert(flags_t::offset<4>() == 4, "Bitpacked members get zero sized slots");
+
+TEST_CASE("Bitpacked standard tuples pack bools and bitfields") {
+  flags_t tup{42, true, false, color::blue, short{3}, true};
+
+  REQUIRE(tup.get<0>() == 42);
+  REQUIRE(tup.get<1>());
+  REQUIRE(!tup.get<2>());
+  REQUIRE(tup.get<3>() == color::blue);
+  REQUIRE(tup.get<4>() == 3);
+  REQUIRE(tup.get<5>());
+
+  tup.get<1>() = false;
+  tup.get<3>() = color::green;
+  tup.get<2>() = tup.get<5>();
+
+  auto const& ctup = tup;
+  REQUIRE(!ctup.get<1>());
+  REQUIRE(ctup.get<2>());
+  REQUIRE(ctup.get<3>() == color::green);
+  REQUIRE(ctup.get<5>());
+
+  auto copy = tup;
+  REQUIRE(copy == tup);
+  copy.get<5>() = false;
+  REQUIRE(copy != tup);
+  copy = tup;
+  REQUIRE(copy.get<5>());
+}
+
+using packed_t = tsar::packed_standard_tuple<char, double, short, int>;
+static_assert(sizeof(packed_t) == 15, "Packed tuples don't have padding");
+static_assert(alignof(packed_t) == 1);
+static_assert(packed_t::offset<1>() == 1);
+static_assert(packed_t::offset<3>() == 11);
+
+TEST_CASE("Packed standard tuples use unaligned accessors") {
+  packed_t tup{'a', 1.5, short{2}, 3};
+
+  REQUIRE(tup.get<0>() == 'a');
+  REQUIRE(tup.get<1>() == 1.5);
+  REQUIRE(tup.get<2>() == 2);
+  REQUIRE(tup.get<3>() == 3);
+
+  tup.get<1>() = 2.5;
+  tup.get<3>() = tup.get<2>();
+
+  auto const& ctup = tup;
+  REQUIRE(ctup.get<1>() == 2.5);
+  REQUIRE(ctup.get<3>() == 2);
+
+  // an array of packed tuples is also unaligned
+  packed_t tups[2] = {tup, tup};
+  tups[1].get<1>() = 4.5;
+  REQUIRE(tups[1].get<1>() == 4.5);
+  REQUIRE(tups[0] == tup);
+}
+
+static_assert(std::is_trivially_copyable_v<tsar::standard_tuple<int, bool, short>>);
+static_assert(std::is_trivially_copyable_v<tsar::sorted_standard_tuple<int, double>>);
+static_assert(std::is_trivially_copyable_v<packed_t>);
+static_assert(std::is_trivially_copyable_v<flags_t>);
+static_assert(!std::is_trivially_copyable_v<tsar::standard_tuple<int, std::function<void()>>>);
+
+TEST_CASE("Trivially copyable standard tuples can be copied as a block") {
+  std::vector<tsar::sorted_standard_tuple<int, bool, double>> v;
+  for (int i = 0; i < 100; ++i) {
+    v.emplace_back(i, i % 2 == 0, i * 0.5);
+  }
+
+  auto copy = v;
+  REQUIRE(copy.size() == 100);
+  REQUIRE(copy[99].get<0>() == 99);
+  REQUIRE(copy[99].get<2>() == 49.5);
+  REQUIRE(copy[98].get<1>());
+
+  copy[0] = copy[99];
+  REQUIRE(copy[0] == copy[99]);
+}
+
+TEST_CASE("Standard tuples can be ordered and hashed") {
+  using bytewise_t = tsar::sorted_standard_tuple<int, short, short>;
+  static_assert(bytewise_t::bytewise_comparable());
+  static_assert(!tsar::standard_tuple<char, int>::bytewise_comparable());
+
+  bytewise_t a{1, short{2}, short{3}};
+  bytewise_t b{1, short{2}, short{4}};
+
+  REQUIRE(a != b);
+  REQUIRE(a < b);
+  REQUIRE(std::hash<bytewise_t>{}(a) == std::hash<bytewise_t>{}(bytewise_t{a}));
+  REQUIRE(std::hash<bytewise_t>{}(a) != std::hash<bytewise_t>{}(b));
+
+  tsar::standard_tuple<double, bool> c{1.0, false};
+  tsar::standard_tuple<double, bool> d{1.0, true};
+  REQUIRE(c < d);
+  REQUIRE(!(c == d));
+  REQUIRE(c != d);
+  REQUIRE(!(c != c));
+  REQUIRE(std::hash<tsar::standard_tuple<double, bool>>{}(c) != std::hash<tsar::standard_tuple<double, bool>>{}(d));
+}
+
+namespace {
+struct key_a {};
+struct key_b {};
+}  // namespace
+
+using st_added_t = decltype(tsar::st<tsar::ordering::optimal>{}.add<char>(key_a{}).add<double>(key_b{}))::tuple_t;
+using st_of_t = tsar::st<tsar::ordering::optimal>::of<tsar::st_entry<key_a, char>, tsar::st_entry<key_b, double>>;
+static_assert(std::is_same_v<st_added_t, st_of_t>);
+
+TEST_CASE("Named standard tuples can be built in one step") {
+  st_of_t t;
+  t.get(key_a{}) = 'x';
+  t.get(key_b{}) = 2.5;
+  REQUIRE(t.get<0>() == 'x');
+  REQUIRE(t.get(key_b{}) == 2.5);
+  REQUIRE(sizeof(st_of_t) == 16);
+}
+
+namespace {
+struct empty_policy {};
+}  // namespace
+
+TEST_CASE("Empty members of standard tuples have distinct addresses, outside of the other members") {
+  tsar::standard_tuple<int, empty_policy, empty_policy> t;
+  auto const* first = reinterpret_cast<const char*>(&t.get<0>());
+  auto const* empty1 = reinterpret_cast<const char*>(&t.get<1>());
+  auto const* empty2 = reinterpret_cast<const char*>(&t.get<2>());
+  REQUIRE(empty1 != empty2);
+  REQUIRE(empty1 >= first + sizeof(int));
+  REQUIRE(empty2 >= first + sizeof(int));
+  REQUIRE(sizeof(t) == 2 * sizeof(int));
+}
@@ -0,0 +1,65 @@
+#include "tsar/static_map.hpp"
+
+#include <string>
+
+#include "catch.hpp"
+#include "tsar/cts.hpp"
+
+using namespace std::literals;
+using namespace tsar;
+
+namespace {
+
+enum class tag { alpha = 3, beta = 1, gamma = 2 };
+
+constexpr auto colors = make_static_map<std::string_view, int>({{"red", 1}, {"green", 2}, {"blue", 3}});
+constexpr auto sizes = make_static_map<int, std::size_t>({{64, 8}, {8, 1}, {32, 4}, {16, 2}});
+constexpr auto tags = make_static_map<tag, std::string_view>({{tag::alpha, "alpha"}, {tag::beta, "beta"}});
+
+}  // namespace
+
+static_assert(*colors.find("green") == 2);
+static_assert(colors.find("yellow") == nullptr);
+static_assert(colors.find("") == nullptr);
+static_assert(colors.size() == 3);
+
+static_assert(sizes.at(32) == 4);
+static_assert(!sizes.contains(0));
+static_assert(!sizes.contains(100));
+static_assert(sizes.keys() == std::array<int, 4>{8, 16, 32, 64});
+
+static_assert(tags.at(tag::beta) == "beta");
+static_assert(!tags.contains(tag::gamma));
+
+// cts names can be used as keys through their views
+static_assert(colors.contains("blue"_s.view()));
+
+TEST_CASE("Static maps find keys built at runtime") {
+  const std::string red = "red";
+  REQUIRE(colors.find(red) != nullptr);
+  REQUIRE(*colors.find(red) == 1);
+  REQUIRE(colors.find(red + "dish") == nullptr);
+
+  for (int k : {8, 16, 32, 64}) {
+    REQUIRE(sizes.at(k) == static_cast<std::size_t>(k / 8));
+  }
+  REQUIRE_THROWS_AS(sizes.at(7), std::out_of_range);
+}
+
+TEST_CASE("Static maps work with many keys") {
+  static constexpr auto squares = [] {
+    std::array<std::pair<int, int>, 300> entries{};
+    for (int i = 0; i < 300; ++i) {
+      entries[i] = {299 - i, (299 - i) * (299 - i)};
+    }
+    return static_map<int, int, 300>{entries};
+  }();
+
+  for (int i = -1; i <= 300; ++i) {
+    if (i < 0 || i == 300) {
+      REQUIRE_FALSE(squares.contains(i));
+    } else {
+      REQUIRE(squares.at(i) == i * i);
+    }
+  }
+}
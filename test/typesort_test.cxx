@@ -1,6 +1,11 @@
 
 #include "tsar/typesort.hpp"
 
+#include <cstdint>
+#include <type_traits>
+
+#include "tsar/standard_storage.hpp"
+
 static_assert(tsar::larger_or_earlier_types<int, int, double, int>(0) == 1);
 static_assert(tsar::larger_or_earlier_types<int, int, double, int>(1) == 2);
 static_assert(tsar::larger_or_earlier_types<int, int, double, int>(2) == 0);
@@ -56,4 +61,99 @@ static_assert(ordered_offsets[3].align == 4);
 static_assert(ordered_offsets[4].align == 1);
 static_assert(ordered_offsets[5].align == 1);
 
+static_assert(tsar::calculate_layout_stats(ordered_offsets).size == 24);
+static_assert(tsar::calculate_layout_stats(ordered_offsets).padding == 0);
+
+static const constexpr auto original_offsets = tsar::calculate_offsets(tsar::original_type_order<char, int, char, double>());
+static_assert(tsar::calculate_layout_stats(original_offsets).size == 24);
+static_assert(tsar::calculate_layout_stats(original_offsets).padding == 10);
+
+struct ch5 {
+  char c[5];
+};
+
+using mixed_report = tsar::layout_report<ch3, std::int16_t, std::int32_t, ch5>;
+static_assert(mixed_report::original_size == 20);
+static_assert(mixed_report::optimal_size == 16);
+static_assert(mixed_report::bytes_saved == 4);
+
+static_assert(tsar::standard_storage<tsar::ordering::original, ch3, std::int16_t, std::int32_t, ch5>::padding_in_bytes() == 3);
+static_assert(tsar::standard_storage<tsar::ordering::optimal, ch3, std::int16_t, std::int32_t, ch5>::padding_in_bytes() == 0);
+static_assert(tsar::standard_storage<tsar::ordering::optimal, ch3, std::int16_t, std::int32_t, ch5>::size_in_bytes() == 14);
+
+// The optimal ordering never has padding between the members
+template <typename... T>
+constexpr bool no_padding = tsar::standard_storage<tsar::ordering::optimal, T...>::padding_in_bytes() == 0;
+
+struct alignas(16) over_aligned {
+  char c;
+};
+
+static_assert(no_padding<char, double, short, ch3, int, ch5, long double, bool>);
+static_assert(no_padding<over_aligned, char, over_aligned, short, ch5>);
+
+// Cache groups start on their own cache line, and are sorted after the ungrouped members
+using tsar::cache_group;
+using grouped_t = tsar::standard_storage<tsar::ordering::optimal, char, cache_group<0, int>, cache_group<1, int>,
+                                         cache_group<0, double>, short>;
+static_assert(std::is_same_v<grouped_t::nth_type<1>, int>);
+static_assert(grouped_t::offset_for(4) == 0);
+static_assert(grouped_t::offset_for(0) == 2);
+static_assert(grouped_t::offset_for(3) == 64);
+static_assert(grouped_t::offset_for(1) == 72);
+static_assert(grouped_t::offset_for(2) == 128);
+static_assert(alignof(grouped_t) == tsar::cache_line_size);
+static_assert(sizeof(grouped_t) == 192);
+
+// The original ordering keeps the order, but still starts a new line at every group change
+using grouped_original_t =
+    tsar::standard_storage<tsar::ordering::original, cache_group<0, int>, cache_group<0, int>, cache_group<1, int>, int>;
+static_assert(grouped_original_t::offset_for(1) == 4);
+static_assert(grouped_original_t::offset_for(2) == 64);
+static_assert(grouped_original_t::offset_for(3) == 128);
+
+// Bitfields never span two words
+static constexpr auto bit_slots = tsar::calculate_bit_slots<8>(std::array<std::size_t, 4>{3, 0, 4, 2});
+static_assert(bit_slots[0].word == 0 && bit_slots[0].shift == 0);
+static_assert(bit_slots[1].bits == 0);
+static_assert(bit_slots[2].word == 0 && bit_slots[2].shift == 3);
+static_assert(bit_slots[3].word == 1 && bit_slots[3].shift == 0);
+static_assert(tsar::calculate_bit_word_count(bit_slots) == 2);
+static_assert(std::is_same_v<tsar::bit_word_t<20>, std::uint32_t>);
+
+// The packed ordering keeps the declaration order, without padding
+using packed_storage_t = tsar::standard_storage<tsar::ordering::packed, char, double, short>;
+static_assert(packed_storage_t::size_in_bytes() == 11);
+static_assert(packed_storage_t::padding_in_bytes() == 0);
+static_assert(packed_storage_t::offset_for(1) == 1);
+static_assert(packed_storage_t::is_unaligned<1>());
+
+// Empty members get a byte of their own, after the other members
+struct empty_policy {};
+struct alignas(8) aligned_empty_policy {};
+using empty_storage_t = tsar::standard_storage<tsar::ordering::optimal, char, empty_policy, int, aligned_empty_policy>;
+static_assert(empty_storage_t::offset_for(2) == 0);
+static_assert(empty_storage_t::offset_for(0) == 4);
+static_assert(empty_storage_t::offset_for(3) == 8);
+static_assert(empty_storage_t::offset_for(1) == 9);
+static_assert(empty_storage_t::size_in_bytes() == 10);
+static_assert(empty_storage_t::padding_in_bytes() == 3);
+static_assert(sizeof(empty_storage_t) == 16);
+
+// Repeated empty types get distinct offsets, and never overlap the other members
+using repeated_empty_t = tsar::standard_storage<tsar::ordering::original, empty_policy, int, empty_policy>;
+static_assert(repeated_empty_t::offset_for(0) == 4);
+static_assert(repeated_empty_t::offset_for(2) == 5);
+static_assert(sizeof(repeated_empty_t) == 2 * sizeof(int));
+using repeated_aligned_empty_t =
+    tsar::standard_storage<tsar::ordering::optimal, char, aligned_empty_policy, aligned_empty_policy>;
+static_assert(repeated_aligned_empty_t::offset_for(1) == 8);
+static_assert(repeated_aligned_empty_t::offset_for(2) == 16);
+static_assert(repeated_aligned_empty_t::size_in_bytes() == 17);
+static_assert(repeated_aligned_empty_t::padding_in_bytes() == 14);
+
+static_assert(sizeof(tsar::standard_storage<tsar::ordering::optimal, empty_policy>) == 1);
+static_assert(!tsar::standard_storage<tsar::ordering::packed, char, empty_policy>::is_unaligned<1>());
+static_assert(tsar::standard_storage<tsar::ordering::original, cache_group<0, empty_policy>, int>::offset_for(1) == 0);
+
 int main() { return 0; }
@@ -0,0 +1,86 @@
+#include "tsar/view.hpp"
+
+#include <vector>
+
+#include "catch.hpp"
+#include "tsar/serialize.hpp"
+
+using namespace tsar;
+
+namespace {
+
+TSAR_STRUCT(record) {
+  TSAR_FIELD(int, id);
+  TSAR_FIELD(char, kind);
+  TSAR_FIELD(double, value);
+};
+
+TSAR_STRUCT(with_scratch) {
+  TSAR_FIELD(int, a);
+  double scratch;  // not a field, isn't serialized
+  TSAR_FIELD(int, b);
+};
+
+}  // namespace
+
+static_assert(std::is_same_v<view<record>::nth_type<2>, double>);
+
+TEST_CASE("Views read serialized records without constructing them") {
+  record r{};
+  r.id = 42;
+  r.kind = 'k';
+  r.value = 1.25;
+
+  std::vector<std::byte> buffer;
+  serialize(r, buffer);
+
+  REQUIRE(buffer.size() == view<record>::record_size());
+
+  view<record> v{buffer};
+  REQUIRE(v.get<0>() == 42);
+  REQUIRE(v.get<1>() == 'k');
+  REQUIRE(v->value == 1.25);
+  REQUIRE(v.fields().id == 42);
+}
+
+TEST_CASE("Views work on unaligned arrays of records") {
+  std::vector<std::byte> buffer(1);
+  for (int i = 0; i < 3; ++i) {
+    record r{};
+    r.id = i;
+    r.value = i * 0.5;
+    serialize(r, buffer);
+  }
+
+  constexpr std::size_t size = view<record>::record_size();
+  auto bytes = std::span<const std::byte>{buffer}.subspan(1);
+  REQUIRE(bytes.size() == 3 * size);
+  for (int i = 0; i < 3; ++i) {
+    view<record> v{bytes.subspan(i * size)};
+    REQUIRE(v->id == i);
+    REQUIRE(v->value == i * 0.5);
+  }
+}
+
+TEST_CASE("Views skip plain members between the fields, like serialize") {
+  std::vector<std::byte> buffer;
+  for (int i = 0; i < 2; ++i) {
+    with_scratch w{};
+    w.a = i;
+    w.scratch = 1.5;
+    w.b = 10 + i;
+    serialize(w, buffer);
+  }
+
+  static_assert(view<with_scratch>::record_size() == 2 * sizeof(int));
+  REQUIRE(buffer.size() == 2 * view<with_scratch>::record_size());
+
+  view<with_scratch> second{std::span<const std::byte>{buffer}.subspan(view<with_scratch>::record_size())};
+  REQUIRE(second->a == 1);
+  REQUIRE(second->b == 11);
+}
+
+TEST_CASE("Views check the size of the buffer") {
+  std::vector<std::byte> buffer(view<record>::record_size() - 1);
+  REQUIRE_THROWS_AS(view<record>{buffer}, std::out_of_range);
+}